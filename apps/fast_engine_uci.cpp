@@ -5,19 +5,27 @@
 #include <cctype>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <vector>
 #include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
 
 #include "chess.hpp"
 #include "fast_engine/engine.hpp"
 #include "fast_engine/config.hpp"
 #include "fast_engine/evaluation.hpp"
+#include "fast_engine/numa.hpp"
 #include "fast_engine/path_utils.hpp"
+#include "fast_engine/selfplay.hpp"
 #include "fast_engine/tablebase.hpp"
+#include "fast_engine/worker_thread.hpp"
 
 using fast_engine::Engine;
 using fast_engine::EngineConfig;
@@ -156,23 +164,146 @@ static void append_uci_score(std::ostringstream &info, Score score)
     }
 }
 
-// UCI output can come from the main thread and the search thread.
+// Iteration "info" output.
+
+static std::string format_iteration_info(const IterationInfo &iter)
+{
+    std::ostringstream info;
+    info << "info depth " << iter.depth;
+    append_uci_score(info, iter.score);
+    info << " nodes " << iter.nodes;
+    info << " time " << static_cast<int>(std::llround(iter.time_seconds * 1000.0));
+    info << " nps " << static_cast<long long>(std::llround(iter.nps));
+    if (iter.tb_hits > 0)
+        info << " tbhits " << iter.tb_hits;
+    if (!iter.pv_uci.empty())
+        info << " pv " << iter.pv_uci;
+    return info.str();
+}
+
+// UCI output can come from the main thread and the search thread. Producers push onto a
+// lock-free MPSC queue (Vyukov's intrusive list) and a dedicated output thread formats and
+// writes, so neither string building for "info" lines nor a slow stdout reader stalls the
+// search. Lines leave in push order; the destructor drains the queue.
 
 struct UciIO
 {
-    std::mutex mutex;
+    enum class Kind : std::uint8_t
+    {
+        Out,
+        Err,
+        Iteration
+    };
+
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        Kind kind = Kind::Out;
+        std::string text;
+        IterationInfo iter{};
+    };
+
+    UciIO()
+        : head_(&stub_storage_), tail_(&stub_storage_), writer_(&UciIO::write_loop, this)
+    {
+    }
+
+    ~UciIO()
+    {
+        stopping_.store(true, std::memory_order_release);
+        posted_.fetch_add(1, std::memory_order_release);
+        posted_.notify_one();
+        writer_.join();
+        if (tail_ != &stub_storage_)
+            delete tail_;
+    }
+
+    UciIO(const UciIO &) = delete;
+    UciIO &operator=(const UciIO &) = delete;
 
     void log(const std::string &line)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        std::cerr << line << std::endl;
+        Node *node = new Node();
+        node->kind = Kind::Err;
+        node->text = line;
+        push(node);
     }
 
     void send(const std::string &line)
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        std::cout << line << std::endl;
+        Node *node = new Node();
+        node->text = line;
+        push(node);
     }
+
+    void send_iteration(const IterationInfo &iter)
+    {
+        Node *node = new Node();
+        node->kind = Kind::Iteration;
+        node->iter = iter;
+        push(node);
+    }
+
+private:
+    void push(Node *node)
+    {
+        Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+        posted_.fetch_add(1, std::memory_order_release);
+        posted_.notify_one();
+    }
+
+    // Consumer side: the node at tail_ is a spent stub; its successor carries the next line
+    // and becomes the new stub once its text has been taken.
+    bool drain()
+    {
+        bool out = false;
+        bool err = false;
+        for (Node *next = tail_->next.load(std::memory_order_acquire); next;
+             next = tail_->next.load(std::memory_order_acquire))
+        {
+            if (next->kind == Kind::Err)
+            {
+                std::cerr << next->text << '\n';
+                err = true;
+            }
+            else
+            {
+                std::cout << (next->kind == Kind::Iteration ? format_iteration_info(next->iter) : next->text) << '\n';
+                out = true;
+            }
+            if (tail_ != &stub_storage_)
+                delete tail_;
+            tail_ = next;
+        }
+        if (out)
+            std::cout.flush();
+        if (err)
+            std::cerr.flush();
+        return out || err;
+    }
+
+    void write_loop()
+    {
+        for (;;)
+        {
+            const std::uint32_t seen = posted_.load(std::memory_order_acquire);
+            drain();
+            if (stopping_.load(std::memory_order_acquire))
+            {
+                drain();
+                return;
+            }
+            posted_.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    Node stub_storage_;
+    std::atomic<Node *> head_;
+    Node *tail_;
+    std::atomic<std::uint32_t> posted_{0};
+    std::atomic<bool> stopping_{false};
+    std::thread writer_;
 };
 
 static bool model_loaded_for_backend(EvalBackend backend) noexcept;
@@ -180,10 +311,26 @@ static bool load_model_for_backend(EvalBackend backend, const std::string &path,
 
 static std::string resolved_model_path_for_load(const std::string &path)
 {
+    if (path == fast_engine::EMBEDDED_NEURAL_MODEL_PATH)
+        return path;
     const std::filesystem::path resolved = fast_engine::resolve_model_path_upward(path);
     return resolved.empty() ? path : resolved.string();
 }
 
+// Says where HalfKP quant weights are served from: the embedded net or a binary file mapping.
+static void send_model_loaded_info(UciIO &io, EvalBackend backend, const std::string &path)
+{
+    const char *source = "";
+    if (backend_uses_halfkp_quant_model(backend))
+    {
+        if (fast_engine::neural_halfkp_quant_model_path() == fast_engine::EMBEDDED_NEURAL_MODEL_PATH)
+            source = " (embedded)";
+        else if (fast_engine::neural_halfkp_quant_model_mapped())
+            source = " (mapped)";
+    }
+    io.send("info string NeuralModelPath loaded " + path + source);
+}
+
 static bool ensure_neural_model_loaded_for_config(const EngineConfig &config, UciIO *io = nullptr)
 {
     if (!backend_uses_external_model(config.eval_backend))
@@ -211,7 +358,7 @@ static bool ensure_neural_model_loaded_for_config(const EngineConfig &config, Uc
     if (load_model_for_backend(config.eval_backend, resolved_path, error))
     {
         if (io)
-            io->send("info string NeuralModelPath loaded " + resolved_path);
+            send_model_loaded_info(*io, config.eval_backend, resolved_path);
         return true;
     }
 
@@ -255,19 +402,9 @@ static bool load_model_for_backend(EvalBackend backend, const std::string &path,
     return true;
 }
 
-// Iteration "info" output.
-
 static void print_iteration_info(UciIO &io, const IterationInfo &iter)
 {
-    std::ostringstream info;
-    info << "info depth " << iter.depth;
-    append_uci_score(info, iter.score);
-    info << " nodes " << iter.nodes;
-    info << " time " << static_cast<int>(std::llround(iter.time_seconds * 1000.0));
-    info << " nps " << static_cast<long long>(std::llround(iter.nps));
-    if (!iter.pv_uci.empty())
-        info << " pv " << iter.pv_uci;
-    io.send(info.str());
+    io.send_iteration(iter);
 }
 
 // Trim helpers.
@@ -295,6 +432,13 @@ static std::string trim(const std::string &s)
     return rtrim(ltrim(s));
 }
 
+// Reports how the TT and eval cache ended up backed (huge pages or ordinary pages).
+static void send_page_mode_info(const Engine &engine, UciIO &io)
+{
+    io.send(std::string("info string Hash pages ") + fast_engine::page_mode_name(engine.ttPageMode()) +
+            " EvalCache pages " + fast_engine::page_mode_name(engine.evalCachePageMode()));
+}
+
 // UCI option handling.
 
 static void handle_setoption(const std::string &line,
@@ -408,7 +552,7 @@ static void handle_setoption(const std::string &line,
                 std::string error;
                 const std::string resolved_path = resolved_model_path_for_load(value);
                 if (load_model_for_backend(config.eval_backend, resolved_path, error))
-                    io.send("info string NeuralModelPath loaded " + resolved_path);
+                    send_model_loaded_info(io, config.eval_backend, resolved_path);
                 else
                     io.send("info string NeuralModelPath load failed: " + error);
             }
@@ -418,6 +562,11 @@ static void handle_setoption(const std::string &line,
             }
         }
     }
+    else if (name == "NeuralSharedImageDir")
+    {
+        const std::string dir = fast_engine::set_neural_shared_image_dir(value);
+        io.send("info string NeuralSharedImageDir " + (dir.empty() ? std::string("disabled") : dir));
+    }
     else if (name == "NeuralEndgameFallback")
     {
         if (!value.empty())
@@ -442,6 +591,11 @@ static void handle_setoption(const std::string &line,
         if (!value.empty())
             config.neural_accumulator_check = parse_bool_option(value);
     }
+    else if (name == "NeuralAccumulatorLazy")
+    {
+        if (!value.empty())
+            config.neural_accumulator_lazy = parse_bool_option(value);
+    }
     else if (name == "SyzygyPath")
     {
         config.syzygy_path = value;
@@ -460,6 +614,15 @@ static void handle_setoption(const std::string &line,
         if (!value.empty())
             config.syzygy_root_probe = parse_bool_option(value);
     }
+    else if (name == "SyzygyProbeDepth")
+    {
+        if (!value.empty())
+        {
+            int v = std::stoi(value);
+            v = std::max(0, std::min(64, v));
+            config.syzygy_probe_depth = v;
+        }
+    }
     else if (name == "MaterialScale")
     {
         if (!value.empty())
@@ -822,6 +985,10 @@ static void handle_setoption(const std::string &line,
     {
         config.use_move_count_pruning = parse_bool_option(value);
     }
+    else if (name == "SearchCarryover")
+    {
+        config.search_carryover = parse_bool_option(value);
+    }
     else if (name == "UseCorrectionHistory")
     {
         config.use_correction_history = parse_bool_option(value);
@@ -842,9 +1009,42 @@ static void handle_setoption(const std::string &line,
             int mb = std::max(1, std::stoi(value));
             config.hash_mb = mb;
             if (engine)
+            {
                 engine->resizeTT_MB(static_cast<std::size_t>(mb));
+                send_page_mode_info(*engine, io);
+            }
+        }
+    }
+    else if (name == "EvalCacheMB")
+    {
+        if (!value.empty())
+        {
+            config.eval_cache_mb = std::clamp(std::stoi(value), 1, 4096);
+            if (engine)
+            {
+                engine->setConfig(config);
+                send_page_mode_info(*engine, io);
+            }
         }
     }
+    else if (name == "PawnHashMB")
+    {
+        if (!value.empty())
+            config.pawn_hash_mb = std::clamp(std::stoi(value), 1, 1024);
+    }
+    else if (name == "Threads")
+    {
+        if (!value.empty())
+            config.threads = std::clamp(std::stoi(value), 1, fast_engine::MAX_SEARCH_THREADS);
+    }
+    else if (name == "NumaPolicy")
+    {
+        if (!fast_engine::parse_numa_policy(to_lower(value), config.numa_policy))
+            io.send("info string NumaPolicy expects none or auto");
+        else
+            io.send("info string NumaPolicy " + std::string(fast_engine::numa_policy_name(config.numa_policy)) +
+                    " (" + std::to_string(fast_engine::numa_node_count()) + " node(s))");
+    }
     else if (name == "MaxDepthTimed")
     {
         if (!value.empty())
@@ -870,7 +1070,7 @@ static void handle_setoption(const std::string &line,
         if (option_changes_static_eval(name))
         {
             engine->clearTT();
-            fast_engine::clear_eval_cache();
+            engine->clearEvalCache();
         }
     }
 }
@@ -1128,7 +1328,9 @@ static bool run_neural_accumulator_selftest(const EngineConfig &config, UciIO &i
             << " refreshes=" << test.stats.refreshes
             << " invalid=" << test.stats.invalid_fallbacks
             << " deltas=" << test.stats.delta_updates
-            << " check_failures=" << test.stats.check_failures;
+            << " check_failures=" << test.stats.check_failures
+            << " king_cache=" << test.stats.king_cache_refreshes
+            << " skipped=" << test.stats.skipped_updates;
     io.send(summary.str());
     return test.failures == 0;
 }
@@ -1203,6 +1405,312 @@ static chess::Move ensure_legal_or_fallback(const chess::Board &board, chess::Mo
     return ml[0];
 }
 
+// PROFILE=1 stage timers as "[GO]" keys: prof<Stage>Cyc (inclusive cycles) and prof<Stage>Calls.
+static void append_profile_keys(std::ostream &os, const fast_engine::ProfileCounters &profile)
+{
+    for (int i = 0; i < fast_engine::PROFILE_STAGE_COUNT; ++i)
+    {
+        const std::size_t s = static_cast<std::size_t>(i);
+        os << " prof" << fast_engine::PROFILE_STAGE_NAMES[s] << "Cyc=" << profile.cycles[s]
+           << " prof" << fast_engine::PROFILE_STAGE_NAMES[s] << "Calls=" << profile.calls[s];
+    }
+}
+
+// ----------------- bench / perft -----------------
+
+// Same suite as docs/uci_benchmark_runner.py so native and scripted numbers line up.
+static const char *const BENCH_FENS[] = {
+    "r1b1kb1r/p1pn1ppp/2p1P3/3p4/5B2/2N5/PqP1QPPP/R3KB1R w KQkq - 0 11",
+    "r1bq1rk1/ppppnpp1/7p/n7/2B1PN2/4PN2/PP4PP/R2Q1RK1 w - - 3 12",
+    "r1b1r1k1/pp3ppp/5b2/3qn3/3pB1PP/5Q2/PPPN1P2/R1B1K2R w KQ - 5 15",
+    "6k1/1p3rpp/p1p3q1/P1Pr4/3PbP2/1Q2R1BP/6P1/3R2K1 b - - 1 27",
+    "k3rr2/p1p5/1qbb2pp/2N5/PP5Q/2P1B3/6PP/R3R1K1 b - - 0 24",
+    "5k2/pprq1ppp/4pb1B/3n4/P5QP/1P3B2/5PP1/3R2K1 w - - 1 26",
+    "8/pp3p2/2p3p1/3k4/5PPP/P7/5K2/8 w - - 1 37",
+    "5kb1/8/8/1K6/1P6/P7/8/8 w - - 3 59",
+    "8/1pp5/3p4/pP1Pp1k1/P1P2pPp/3P1P2/8/5K2 w - - 3 39",
+};
+
+constexpr int BENCH_DEFAULT_DEPTH = 12;
+
+// "bench [depth] [threads] [hash]": fixed-depth search of BENCH_FENS, each from a clean
+// TT / history / eval-cache state like a fresh "ucinewgame". With Threads=1 the node
+// total and signature are deterministic for a given build and option set.
+static void run_bench(const std::string &line, const EngineConfig &config, UciIO &io)
+{
+    std::istringstream iss(line);
+    std::string token;
+    iss >> token; // "bench"
+    int depth = BENCH_DEFAULT_DEPTH;
+    int threads = 1;
+    int hash_mb = 16;
+    if (iss >> token)
+        depth = std::clamp(std::atoi(token.c_str()), 1, 64);
+    if (iss >> token)
+        threads = std::clamp(std::atoi(token.c_str()), 1, fast_engine::MAX_SEARCH_THREADS);
+    if (iss >> token)
+        hash_mb = std::clamp(std::atoi(token.c_str()), 1, 4096);
+
+    EngineConfig cfg = config;
+    cfg.threads = threads;
+    cfg.hash_mb = hash_mb;
+    if (!neural_backend_ready(cfg, io))
+    {
+        io.send("info string bench falling back to hce");
+        cfg.eval_backend = EvalBackend::Hce;
+    }
+
+    Engine engine(cfg);
+    fast_engine::ProfileCounters profile{};
+    fast_engine::EvalCacheStats cache_stats{};
+    std::uint64_t total_nodes = 0;
+    std::uint64_t signature = 0xcbf29ce484222325ULL;
+    const auto start = std::chrono::steady_clock::now();
+    int index = 0;
+    for (const char *fen : BENCH_FENS)
+    {
+        ++index;
+        engine.resetHeuristics();
+        engine.clearEvalCache();
+        engine.clearTT();
+
+        chess::Board board(fen);
+        SearchResult result{};
+        engine.search_position(board, depth, result, nullptr);
+        total_nodes += result.nodes;
+        profile.add(result.profile);
+        cache_stats.add(result.eval_cache);
+        signature = (signature ^ result.nodes) * 0x100000001b3ULL;
+
+        std::ostringstream oss;
+        oss << "info string bench " << index << "/" << std::size(BENCH_FENS)
+            << " nodes " << result.nodes
+            << " bestmove " << (result.has_best_move ? chess::uci::moveToUci(result.best_move) : std::string("0000"));
+        io.send(oss.str());
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ostringstream oss;
+    oss << "info string bench depth " << depth
+        << " threads " << threads
+        << " hash " << hash_mb
+        << " backend " << eval_backend_uci_name(cfg.eval_backend)
+        << " nodes " << total_nodes
+        << " time " << static_cast<long long>(std::llround(seconds * 1000.0))
+        << " nps " << static_cast<long long>(seconds > 0.0 ? std::llround(static_cast<double>(total_nodes) / seconds) : 0)
+        << " signature " << std::hex << std::setw(16) << std::setfill('0') << signature;
+    io.send(oss.str());
+
+    std::ostringstream cache_out;
+    cache_out << "info string bench evalcache hits " << cache_stats.eval_hits
+              << " misses " << cache_stats.eval_misses
+              << " pawnhash hits " << cache_stats.pawn_hits
+              << " misses " << cache_stats.pawn_misses;
+    io.send(cache_out.str());
+
+    if constexpr (fast_engine::PROFILE_ENABLED)
+    {
+        for (int i = 0; i < fast_engine::PROFILE_STAGE_COUNT; ++i)
+        {
+            const std::size_t st = static_cast<std::size_t>(i);
+            const std::uint64_t calls = profile.calls[st];
+            std::ostringstream line_out;
+            line_out << "info string bench profile " << fast_engine::PROFILE_STAGE_NAMES[st]
+                     << " cycles " << profile.cycles[st]
+                     << " calls " << calls
+                     << " avg " << (calls > 0 ? profile.cycles[st] / calls : 0)
+                     << " per_node " << std::fixed << std::setprecision(1)
+                     << (total_nodes > 0 ? static_cast<double>(profile.cycles[st]) / static_cast<double>(total_nodes) : 0.0);
+            io.send(line_out.str());
+        }
+    }
+}
+
+// "selfplay [games N] [threads N] [depth N] [movetime ms] [random N] [maxplies N] [hash MB]
+// [seed N] [openings <file>] [log <file>]": plays games between two copies of the current
+// config in-process, one Engine pair per worker thread. Openings are FENs, one per line.
+static void run_selfplay_command(const std::string &line, const EngineConfig &config, UciIO &io)
+{
+    std::istringstream iss(line);
+    std::string token;
+    iss >> token; // "selfplay"
+    fast_engine::SelfplayOptions options;
+    std::string openings_path;
+    std::string key;
+    while (iss >> key && iss >> token)
+    {
+        const int v = std::atoi(token.c_str());
+        if (key == "games")
+            options.games = std::max(1, v);
+        else if (key == "threads")
+            options.threads = std::clamp(v, 1, fast_engine::MAX_SEARCH_THREADS);
+        else if (key == "depth")
+            options.depth = std::clamp(v, 1, 64);
+        else if (key == "movetime")
+            options.movetime_ms = v;
+        else if (key == "random")
+            options.random_plies = std::clamp(v, 0, 64);
+        else if (key == "maxplies")
+            options.max_plies = std::max(1, v);
+        else if (key == "hash")
+            options.hash_mb = std::clamp(v, 1, 4096);
+        else if (key == "seed")
+            options.seed = std::strtoull(token.c_str(), nullptr, 10);
+        else if (key == "openings")
+            openings_path = token;
+        else if (key == "log")
+            options.log_path = token;
+    }
+
+    if (!openings_path.empty())
+    {
+        std::ifstream in(openings_path);
+        if (!in)
+        {
+            io.send("info string selfplay cannot open openings file " + openings_path);
+            return;
+        }
+        std::string fen;
+        while (std::getline(in, fen))
+        {
+            fen = trim(fen);
+            if (!fen.empty() && fen[0] != '#')
+                options.openings.push_back(fen);
+        }
+    }
+
+    EngineConfig cfg = config;
+    if (!neural_backend_ready(cfg, io))
+    {
+        io.send("info string selfplay falling back to hce");
+        cfg.eval_backend = EvalBackend::Hce;
+    }
+    options.config[0] = cfg;
+    options.config[1] = cfg;
+
+    fast_engine::SelfplaySummary summary;
+    std::string error;
+    if (!fast_engine::run_selfplay(options, summary, error))
+    {
+        io.send("info string selfplay " + error);
+        return;
+    }
+
+    std::ostringstream oss;
+    oss << "info string selfplay games " << summary.games
+        << " a_wins " << summary.a_wins
+        << " b_wins " << summary.b_wins
+        << " draws " << summary.draws
+        << " plies " << summary.plies
+        << " nodes " << summary.nodes
+        << " time " << static_cast<long long>(std::llround(summary.seconds * 1000.0))
+        << " games_per_s " << std::fixed << std::setprecision(2)
+        << (summary.seconds > 0.0 ? static_cast<double>(summary.games) / summary.seconds : 0.0);
+    io.send(oss.str());
+}
+
+static std::uint64_t perft_count(chess::Board &board, int depth)
+{
+    chess::Movelist moves;
+    chess::movegen::legalmoves(moves, board);
+    if (depth <= 1)
+        return static_cast<std::uint64_t>(moves.size());
+
+    std::uint64_t nodes = 0;
+    for (const chess::Move &move : moves)
+    {
+        board.makeMove(move);
+        nodes += perft_count(board, depth - 1);
+        board.unmakeMove(move);
+    }
+    return nodes;
+}
+
+// "perft <depth>": legal-move-generation count from the current position with per-root-move
+// divide lines, timing chess::movegen on its own (leaf level is bulk-counted).
+static void run_perft(const std::string &line, const chess::Board &root, UciIO &io)
+{
+    std::istringstream iss(line);
+    std::string token;
+    iss >> token; // "perft"
+    int depth = 5;
+    if (iss >> token)
+        depth = std::clamp(std::atoi(token.c_str()), 1, 16);
+
+    chess::Board board = root;
+    chess::Movelist moves;
+    chess::movegen::legalmoves(moves, board);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t total = 0;
+    for (const chess::Move &move : moves)
+    {
+        std::uint64_t nodes = 1;
+        if (depth > 1)
+        {
+            board.makeMove(move);
+            nodes = perft_count(board, depth - 1);
+            board.unmakeMove(move);
+        }
+        total += nodes;
+        io.send("info string perft " + chess::uci::moveToUci(move) + " " + std::to_string(nodes));
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ostringstream oss;
+    oss << "info string perft depth " << depth
+        << " nodes " << total
+        << " time " << static_cast<long long>(std::llround(seconds * 1000.0))
+        << " nps " << static_cast<long long>(seconds > 0.0 ? std::llround(static_cast<double>(total) / seconds) : 0);
+    io.send(oss.str());
+}
+
+// "savehash <file> [history]" / "loadhash <file>": TT snapshot (optionally with the main
+// thread's histories) so long analysis sessions survive an engine restart. Loading adopts
+// the saved table size and updates the Hash option to match.
+static void run_hash_snapshot(const std::string &line,
+                              EngineConfig &config,
+                              std::unique_ptr<Engine> &engine,
+                              UciIO &io)
+{
+    std::istringstream iss(line);
+    std::string command;
+    std::string path;
+    std::string extra;
+    iss >> command >> path >> extra;
+    if (path.empty())
+    {
+        io.send("info string usage: savehash <file> [history] | loadhash <file>");
+        return;
+    }
+    if (!engine)
+        engine = std::make_unique<Engine>(config);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string error;
+    const bool save = command == "savehash";
+    const bool ok = save ? engine->saveHash(path, extra == "history", error)
+                         : engine->loadHash(path, error);
+    config.hash_mb = engine->config().hash_mb;
+    if (!ok)
+    {
+        io.send("info string " + command + " failed: " + error);
+        return;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::ostringstream oss;
+    oss << "info string " << command << " " << path
+        << " Hash " << config.hash_mb
+        << " time " << static_cast<long long>(std::llround(seconds * 1000.0));
+    io.send(oss.str());
+    if (!save)
+    {
+        if (!error.empty())
+            io.send("info string loadhash " + error);
+        send_page_mode_info(*engine, io);
+    }
+}
+
 // ----------------- Search worker -----------------
 
 enum class StopReason : int
@@ -1218,7 +1726,7 @@ struct SearchWorker
     std::atomic<bool> stop{false};
     std::atomic<int> stop_reason{static_cast<int>(StopReason::None)};
     std::atomic<bool> suppress_bestmove{false};
-    std::thread th;
+    fast_engine::WorkerThread th; // persistent; one job per "go"
 
     // Protected state
     std::mutex state_m;
@@ -1235,8 +1743,7 @@ struct SearchWorker
 
     void join_if_running()
     {
-        if (th.joinable())
-            th.join();
+        th.wait();
         stop.store(false, std::memory_order_relaxed);
         stop_reason.store(static_cast<int>(StopReason::None), std::memory_order_relaxed);
         suppress_bestmove.store(false, std::memory_order_relaxed);
@@ -1251,11 +1758,28 @@ struct SearchWorker
     }
 };
 
-static chess::Move compute_ponder_move_depth1(Engine &engine, const chess::Board &root, const chess::Move best)
+// Ponder on the PV reply when the search produced one: that is the line the engine
+// carries its search state along. Otherwise fall back to a depth-1 guess.
+static chess::Move compute_ponder_move(Engine &engine, const chess::Board &root, const chess::Move best,
+                                       const std::string &pv_uci)
 {
     chess::Board tmp = root;
     tmp.makeMove(best);
 
+    std::istringstream pv(pv_uci);
+    std::string first;
+    std::string second;
+    if (pv >> first >> second && first == chess::uci::moveToUci(best))
+    {
+        chess::Movelist moves;
+        chess::movegen::legalmoves(moves, tmp);
+        for (const chess::Move &m : moves)
+        {
+            if (chess::uci::moveToUci(m) == second)
+                return m;
+        }
+    }
+
     SearchResult pr{};
     // Depth 1 is fast and generally enough to produce a plausible reply move.
     engine.search_position(tmp, 1, pr, nullptr);
@@ -1370,9 +1894,15 @@ static void print_search_output(UciIO &io,
             << " branch=" << branch
             << " is_mate=" << (result.is_mate ? 1 : 0)
             << " is_draw=" << (result.is_draw ? 1 : 0)
+            << " threads=" << result.threads
             << " tt_hits=" << hits
             << " tt_misses=" << misses
             << " tt_hit_rate=" << std::setprecision(1) << tt_hit_rate << "%"
+            << " tb_hits=" << result.tb_hits
+            << " ec_hits=" << result.eval_cache.eval_hits
+            << " ec_misses=" << result.eval_cache.eval_misses
+            << " ph_hits=" << result.eval_cache.pawn_hits
+            << " ph_misses=" << result.eval_cache.pawn_misses
             << " q10=" << result.quiet_searched_ge10
             << " q10r=" << result.quiet_researched_ge10
             << " pvchg10=" << result.pv_firstmove_changes_ge10
@@ -1420,7 +1950,11 @@ static void print_search_output(UciIO &io,
             << " nnAccRefresh=" << result.neural_accumulator.refreshes
             << " nnAccInvalid=" << result.neural_accumulator.invalid_fallbacks
             << " nnAccDelta=" << result.neural_accumulator.delta_updates
-            << " nnAccCheckFail=" << result.neural_accumulator.check_failures;
+            << " nnAccCheckFail=" << result.neural_accumulator.check_failures
+            << " nnAccKingCache=" << result.neural_accumulator.king_cache_refreshes
+            << " nnAccSkipped=" << result.neural_accumulator.skipped_updates;
+        if constexpr (fast_engine::PROFILE_ENABLED)
+            append_profile_keys(dbg, result.profile);
 
         io.log(dbg.str());
     }
@@ -1445,12 +1979,12 @@ static void start_search_async(SearchWorker &w,
                                bool apply_ponder_move)
 {
     // Stop any current search before replacing worker state.
-    if (w.th.joinable())
+    if (w.th.busy())
     {
         w.stop_reason.store(static_cast<int>(StopReason::Internal), std::memory_order_relaxed);
         w.suppress_bestmove.store(true, std::memory_order_relaxed);
         w.request_stop();
-        w.th.join();
+        w.th.wait();
     }
     w.stop.store(false, std::memory_order_relaxed);
     w.stop_reason.store(static_cast<int>(StopReason::None), std::memory_order_relaxed);
@@ -1511,8 +2045,8 @@ static void start_search_async(SearchWorker &w,
         io.log(tm.str());
     }
 
-    w.th = std::thread([&w, &io, &engine, config, search_board, limits, pondering_mode]() mutable
-                       {
+    w.th.start([&w, &io, &engine, config, search_board, limits, pondering_mode]() mutable
+               {
         SearchResult result{};
 
         // Many GUIs do not expect heavy "info" traffic during ponder and can misbehave
@@ -1569,7 +2103,7 @@ static void start_search_async(SearchWorker &w,
         chess::Move ponder = chess::Move::NO_MOVE;
         if (config.ponder)
         {
-            ponder = compute_ponder_move_depth1(engine, search_board, best);
+            ponder = compute_ponder_move(engine, search_board, best, result.pv_uci);
         }
 
         // Store ponder move for potential future "go ponder".
@@ -1584,12 +2118,12 @@ static void start_search_async(SearchWorker &w,
 
 static void handle_stop(SearchWorker &w, StopReason reason, bool suppress_output)
 {
-    if (w.th.joinable())
+    if (w.th.busy())
     {
         w.stop_reason.store(static_cast<int>(reason), std::memory_order_relaxed);
         w.suppress_bestmove.store(suppress_output, std::memory_order_relaxed);
         w.request_stop();
-        w.th.join();
+        w.th.wait();
     }
     w.stop.store(false, std::memory_order_relaxed);
     w.stop_reason.store(static_cast<int>(StopReason::None), std::memory_order_relaxed);
@@ -1614,7 +2148,8 @@ static void handle_ponderhit(SearchWorker &w,
 
     {
         std::lock_guard<std::mutex> lk(w.state_m);
-        was_pondering = w.pondering && w.th.joinable() && w.have_go_ponder_limits;
+        // `pondering` stays set until the ponder job is stopped, even if it already returned.
+        was_pondering = w.pondering && w.have_go_ponder_limits;
         if (was_pondering)
         {
             saved_limits = w.last_go_ponder_limits;
@@ -1664,11 +2199,14 @@ static void handle_ponderhit(SearchWorker &w,
                        /*apply_ponder_move=*/false);
 }
 
-int main()
+int main(int argc, char **argv)
 {
     UciIO io;
 
     EngineConfig config;
+    // A build with an embedded network uses it by default; NeuralModelPath still overrides.
+    if (fast_engine::embedded_neural_halfkp_quant_model_available())
+        config.neural_model_path = fast_engine::EMBEDDED_NEURAL_MODEL_PATH;
     std::unique_ptr<Engine> engine;
     chess::Board board; // startpos
     // Note: ordering heuristics (history/continuation/capture history) should persist within a game.
@@ -1676,6 +2214,27 @@ int main()
 
     SearchWorker worker;
 
+    // "ShakeyBot bench [depth] [threads] [hash]" / "ShakeyBot perft <depth>" /
+    // "ShakeyBot selfplay ..." run once and exit.
+    if (argc > 1)
+    {
+        std::string command;
+        for (int i = 1; i < argc; ++i)
+            command += (i > 1 ? " " : "") + std::string(argv[i]);
+        if (command.rfind("bench", 0) == 0)
+            run_bench(command, config, io);
+        else if (command.rfind("perft", 0) == 0)
+            run_perft(command, board, io);
+        else if (command.rfind("selfplay", 0) == 0)
+            run_selfplay_command(command, config, io);
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [bench [depth] [threads] [hash] | perft <depth> | selfplay [key value]...]\n";
+            return 2;
+        }
+        return 0;
+    }
+
     std::string line;
     while (std::getline(std::cin, line))
     {
@@ -1701,16 +2260,20 @@ int main()
             io.send("option name MaxDepthTimed type spin default " + std::to_string(config.max_depth_timed) + " min 1 max 128");
             io.send("option name MoveOverhead type spin default " + std::to_string(config.move_overhead_ms) + " min 0 max 2000");
             io.send("option name Ponder type check default " + std::string(as_bool(config.ponder)));
+            io.send("option name SearchCarryover type check default " + std::string(as_bool(config.search_carryover)));
 
             io.send("option name EvalBackend type combo default " + std::string(eval_backend_uci_name(config.eval_backend)) + " var hce var neural_dummy var neural_simple var neural_accum var neural_quant var neural_quant_accum var neural_halfkp var neural_halfkp_quant var neural_halfkp_quant_accum");
             io.send("option name NeuralModelPath type string default " + config.neural_model_path);
+            io.send("option name NeuralSharedImageDir type string default <empty>");
             io.send("option name NeuralEndgameFallback type check default " + std::string(as_bool(config.neural_endgame_fallback)));
             io.send("option name NeuralEndgameMaterialLimit type spin default " + std::to_string(config.neural_endgame_material_limit) + " min 0 max 40");
             io.send("option name NeuralPawnOnlyFallback type check default " + std::string(as_bool(config.neural_pawn_only_fallback)));
             io.send("option name NeuralAccumulatorCheck type check default " + std::string(as_bool(config.neural_accumulator_check)));
+            io.send("option name NeuralAccumulatorLazy type check default " + std::string(as_bool(config.neural_accumulator_lazy)));
             io.send("option name SyzygyPath type string default " + config.syzygy_path);
             io.send("option name SyzygyProbeLimit type spin default " + std::to_string(config.syzygy_probe_limit) + " min 0 max 7");
             io.send("option name SyzygyRootProbe type check default " + std::string(as_bool(config.syzygy_root_probe)));
+            io.send("option name SyzygyProbeDepth type spin default " + std::to_string(config.syzygy_probe_depth) + " min 0 max 64");
 
             // Evaluation scales are exposed as x100 integer multipliers.
             io.send("option name MaterialScale type spin default " + std::to_string(to_cp(config.eval.material)) + " min 0 max 300");
@@ -1741,7 +2304,11 @@ int main()
             io.send("option name TempoBonus type spin default " + std::to_string(config.tempo_bonus_cp) + " min 0 max 50");
             io.send("option name EnableEndgameScaling type check default " + std::string(as_bool(config.enable_endgame_scaling)));
 
-            io.send("option name Hash type spin default " + std::to_string(std::lround(config.hash_mb)) + " min 1 max 4096");
+            io.send("option name Hash type spin default " + std::to_string(std::lround(config.hash_mb)) + " min 1 max " + std::to_string(fast_engine::TT_MAX_MB));
+            io.send("option name EvalCacheMB type spin default " + std::to_string(config.eval_cache_mb) + " min 1 max 4096");
+            io.send("option name PawnHashMB type spin default " + std::to_string(config.pawn_hash_mb) + " min 1 max 1024");
+            io.send("option name Threads type spin default " + std::to_string(config.threads) + " min 1 max " + std::to_string(fast_engine::MAX_SEARCH_THREADS));
+            io.send("option name NumaPolicy type combo default " + std::string(fast_engine::numa_policy_name(config.numa_policy)) + " var none var auto");
             io.send("option name UseQuiescence type check default " + std::string(as_bool(config.use_quiescence)));
             io.send("option name UseRazoring type check default " + std::string(as_bool(config.use_razoring)));
             io.send("option name RazorMarginD2 type spin default " + std::to_string(config.razor_margin_d2) + " min 0 max 3000");
@@ -1794,12 +2361,14 @@ int main()
 
             // Per UCI spec, ucinewgame is emitted once for a new game. Reset stateful
             // move-ordering heuristics and clear the TT here (and only here).
-            fast_engine::reset_search_heuristics();
             if (engine)
+            {
+                engine->resetHeuristics();
                 engine->clearTT();
 
-            // Clear evaluation caches to keep per-game behavior stable.
-            fast_engine::clear_eval_cache();
+                // Clear evaluation caches to keep per-game behavior stable.
+                engine->clearEvalCache();
+            }
         }
         else if (line.rfind("position", 0) == 0)
         {
@@ -1812,6 +2381,26 @@ int main()
             handle_stop(worker, StopReason::Internal, /*suppress_output=*/true);
             (void)run_neural_accumulator_selftest(config, io);
         }
+        else if (line.rfind("bench", 0) == 0)
+        {
+            handle_stop(worker, StopReason::Internal, /*suppress_output=*/true);
+            run_bench(line, config, io);
+        }
+        else if (line.rfind("perft", 0) == 0)
+        {
+            handle_stop(worker, StopReason::Internal, /*suppress_output=*/true);
+            run_perft(line, board, io);
+        }
+        else if (line.rfind("selfplay", 0) == 0)
+        {
+            handle_stop(worker, StopReason::Internal, /*suppress_output=*/true);
+            run_selfplay_command(line, config, io);
+        }
+        else if (line.rfind("savehash", 0) == 0 || line.rfind("loadhash", 0) == 0)
+        {
+            handle_stop(worker, StopReason::Internal, /*suppress_output=*/true);
+            run_hash_snapshot(line, config, engine, io);
+        }
         else if (line.rfind("go", 0) == 0)
         {
             if (!neural_backend_ready(config, io))
@@ -1821,7 +2410,10 @@ int main()
             }
 
             if (!engine)
+            {
                 engine = std::make_unique<Engine>(config);
+                send_page_mode_info(*engine, io);
+            }
 
             fast_engine::SearchLimits limits = parse_go_limits(line);
 
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <string>
+
+#include "fast_engine/evaluation.hpp"
+
+// Converts a SHAKEYBOT_HALFKP_WP_*_QUANT_V1 text model (or an older binary) into the
+// memory-mapped binary format, then reloads the output to verify its checksum.
+//
+//   halfkp_convert <input model> <output.bin>
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << (argc > 0 ? argv[0] : "halfkp_convert") << " <input model> <output.bin>\n";
+        return 2;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+
+    std::string error;
+    if (!fast_engine::load_neural_halfkp_quant_model(input, error))
+    {
+        std::cerr << "load failed: " << error << "\n";
+        return 1;
+    }
+    if (!fast_engine::save_neural_halfkp_quant_model_binary(output, error))
+    {
+        std::cerr << "write failed: " << error << "\n";
+        return 1;
+    }
+    if (!fast_engine::load_neural_halfkp_quant_model(output, error) ||
+        !fast_engine::neural_halfkp_quant_model_mapped())
+    {
+        std::cerr << "verify failed: " << (error.empty() ? "output did not map" : error) << "\n";
+        return 1;
+    }
+    std::cout << "wrote " << output << "\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chess.hpp"
+#include "fast_engine/evaluation.hpp"
+
+// Streams a FEN/EPD file through the batched HalfKP quant evaluator and prints each
+// input line followed by a tab and the White-POV net score in centipawns. EPD opcodes
+// after the four position fields are ignored; unparsable lines and boards the net cannot
+// encode (see neural_halfkp_board_supported) are reported on stderr and skipped. A failed batch exits non-zero.
+//
+//   halfkp_score <model> <positions.fen|epd | -> [threads] [chunk]
+
+namespace
+{
+    // FEN from a FEN or EPD line: the four position fields plus the move counters when
+    // both are plain integers.
+    std::string position_fields(const std::string &line)
+    {
+        std::istringstream in(line);
+        std::vector<std::string> fields;
+        std::string field;
+        while (fields.size() < 6 && in >> field)
+            fields.push_back(field);
+        if (fields.size() < 4)
+            return {};
+        auto is_number = [](const std::string &s)
+        { return !s.empty() && std::all_of(s.begin(), s.end(), [](unsigned char c)
+                                           { return c >= '0' && c <= '9'; }); };
+        std::size_t used = 4;
+        if (fields.size() == 6 && is_number(fields[4]) && is_number(fields[5]))
+            used = 6;
+        std::string fen = fields[0];
+        for (std::size_t i = 1; i < used; ++i)
+            fen += ' ' + fields[i];
+        return fen;
+    }
+
+    bool flush_chunk(std::vector<std::string> &lines, std::vector<chess::Board> &boards, int threads)
+    {
+        std::vector<fast_engine::Score> scores(boards.size());
+        if (!fast_engine::evaluate_batch(boards, scores, threads))
+        {
+            std::cerr << "batch evaluation failed: no HalfKP quant model loaded\n";
+            return false;
+        }
+        for (std::size_t i = 0; i < lines.size(); ++i)
+            std::cout << lines[i] << '\t' << scores[i] << '\n';
+        lines.clear();
+        boards.clear();
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3 || argc > 5)
+    {
+        std::cerr << "usage: " << (argc > 0 ? argv[0] : "halfkp_score")
+                  << " <model> <positions.fen|epd | -> [threads] [chunk]\n";
+        return 2;
+    }
+    const int threads = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+    const std::size_t chunk = argc > 4 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[4]))) : 65536;
+
+    std::string error;
+    if (!fast_engine::load_neural_halfkp_quant_model(argv[1], error))
+    {
+        std::cerr << "load failed: " << error << "\n";
+        return 1;
+    }
+
+    std::ifstream file;
+    const std::string input = argv[2];
+    if (input != "-")
+    {
+        file.open(input);
+        if (!file)
+        {
+            std::cerr << "cannot open " << input << "\n";
+            return 1;
+        }
+    }
+    std::istream &in = input == "-" ? std::cin : file;
+
+    std::vector<std::string> lines;
+    std::vector<chess::Board> boards;
+    lines.reserve(chunk);
+    boards.reserve(chunk);
+    std::uint64_t line_number = 0;
+    std::uint64_t skipped = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        ++line_number;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.find_first_not_of(" \t") == std::string::npos)
+            continue;
+        const std::string fen = position_fields(line);
+        chess::Board board;
+        if (fen.empty() || !board.setFen(fen) || !fast_engine::neural_halfkp_board_supported(board))
+        {
+            std::cerr << "line " << line_number << ": bad FEN\n";
+            ++skipped;
+            continue;
+        }
+        lines.push_back(std::move(line));
+        boards.push_back(std::move(board));
+        if (boards.size() >= chunk && !flush_chunk(lines, boards, threads))
+            return 1;
+    }
+    if (!flush_chunk(lines, boards, threads))
+        return 1;
+    if (skipped > 0)
+        std::cerr << "skipped " << skipped << " lines\n";
+    return 0;
+}
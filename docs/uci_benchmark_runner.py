@@ -53,8 +53,24 @@ AGGREGATE_KEYS = [
     "nnAccInvalid",
     "nnAccDelta",
     "nnAccCheckFail",
+    "nnAccKingCache",
+    "nnAccSkipped",
 ]
 
+# Stage timers reported only by PROFILE=1 builds (inclusive cycles and call counts).
+PROFILE_STAGES = [
+    "HceEval",
+    "NnUpdate",
+    "NnRefresh",
+    "NnOutput",
+    "See",
+    "MoveScore",
+    "TtProbe",
+    "TtStore",
+    "LegalGen",
+]
+PROFILE_KEYS = [f"prof{stage}{suffix}" for stage in PROFILE_STAGES for suffix in ("Cyc", "Calls")]
+
 
 def metric(line: str, key: str, cast: Callable[[str], int | float] = int) -> int | float | None:
     match = re.search(rf"{re.escape(key)}=([-0-9.]+)", line)
@@ -158,6 +174,8 @@ def main() -> int:
 
         totals: dict[str, int | float] = {"positions": 0, "time": 0.0}
         totals.update({key: 0 for key in AGGREGATE_KEYS})
+        totals.update({key: 0 for key in PROFILE_KEYS})
+        have_profile = False
 
         for fen in STANDARD_FENS:
             emit("")
@@ -176,6 +194,11 @@ def main() -> int:
                     value = metric(line, key)
                     if value is not None:
                         totals[key] = int(totals[key]) + int(value)
+                for key in PROFILE_KEYS:
+                    value = metric(line, key)
+                    if value is not None:
+                        have_profile = True
+                        totals[key] = int(totals[key]) + int(value)
                 time_value = metric(line, "time", float)
                 if time_value is not None:
                     totals["time"] = float(totals["time"]) + float(time_value)
@@ -213,8 +236,21 @@ def main() -> int:
             f"nnAccRefresh={totals['nnAccRefresh']} "
             f"nnAccInvalid={totals['nnAccInvalid']} "
             f"nnAccDelta={totals['nnAccDelta']} "
-            f"nnAccCheckFail={totals['nnAccCheckFail']}"
+            f"nnAccCheckFail={totals['nnAccCheckFail']} "
+            f"nnAccKingCache={totals['nnAccKingCache']} "
+            f"nnAccSkipped={totals['nnAccSkipped']}"
         )
+
+        if have_profile:
+            nodes = int(totals["nodes"])
+            emit("")
+            emit("Stage profile (inclusive cycles; nested stages count in both):")
+            for stage in PROFILE_STAGES:
+                cycles = int(totals[f"prof{stage}Cyc"])
+                calls = int(totals[f"prof{stage}Calls"])
+                avg = cycles // calls if calls else 0
+                per_node = cycles / nodes if nodes else 0.0
+                emit(f"{stage:<10} cycles={cycles} calls={calls} avg={avg} per_node={per_node:.1f}")
     finally:
         if out_file:
             out_file.close()
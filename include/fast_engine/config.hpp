@@ -20,6 +20,21 @@ namespace fast_engine
         NeuralHalfkpQuantAccum = 8
     };
 
+    // Search thread placement on multi-socket machines (see numa.hpp). Auto pins threads
+    // to nodes and keeps their hot per-thread state and NNUE weights node-local.
+    enum class NumaPolicy : std::uint8_t
+    {
+        None = 0,
+        Auto = 1
+    };
+
+    // Upper bound for the UCI "Threads" option (main thread + Lazy SMP helpers).
+    constexpr int MAX_SEARCH_THREADS = 128;
+
+    // Default sizes of the shared eval cache and the per-thread pawn hash, in MB.
+    constexpr int EVAL_CACHE_DEFAULT_MB = 64;
+    constexpr int PAWN_HASH_DEFAULT_MB = 24;
+
     struct EngineConfig
     {
         int search_depth = 3;
@@ -79,6 +94,9 @@ namespace fast_engine
         double correction_history_scale = 0.0;
 
         // Time management / UCI
+        // Resume iterative deepening from the previous search's root state on ponderhit
+        // and when the opponent plays the predicted reply (see Engine).
+        bool search_carryover = true;
         int max_depth_timed = 64;
         int move_overhead_ms = 20;
         bool ponder = false;
@@ -133,9 +151,13 @@ namespace fast_engine
         int neural_endgame_material_limit = 1;
         bool neural_pawn_only_fallback = false;
         bool neural_accumulator_check = false;
+        // Defer accumulator updates until a node is evaluated (dirty-piece stack in search).
+        bool neural_accumulator_lazy = true;
 
         bool syzygy_root_probe = true;
         int syzygy_probe_limit = 5;
+        // Minimum remaining depth for WDL probes inside negamax (0 disables them).
+        int syzygy_probe_depth = 1;
         std::string syzygy_path = "Zyzygy_EGTB_345";
 
         // Tempo bonus (centipawns) applied in evaluate_for_side_to_move_with_config().
@@ -155,6 +177,15 @@ namespace fast_engine
         double draw_noise = 0.0; // e.g. 0.02 = 2cp
 
         double hash_mb = 256;
+
+        // Shared full-eval cache size, and pawn hash size per search thread (the king-cover
+        // cache scales with it). Both round down to a power-of-two bucket count.
+        int eval_cache_mb = EVAL_CACHE_DEFAULT_MB;
+        int pawn_hash_mb = PAWN_HASH_DEFAULT_MB;
+
+        // Search threads (Lazy SMP). 1 = single-threaded search.
+        int threads = 1;
+        NumaPolicy numa_policy = NumaPolicy::None;
     };
 
     // Base piece value in pawns, with sign applied (+ for White, - for Black).
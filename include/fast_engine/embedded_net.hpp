@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace fast_engine
+{
+
+    // Binary HalfKP quant model linked into the executable with `make EMBED_NET=<model.bin>`.
+    // `size` is zero when the build embeds no network.
+    struct EmbeddedNet
+    {
+        const unsigned char *data = nullptr;
+        std::size_t size = 0;
+    };
+
+    EmbeddedNet embedded_net() noexcept;
+
+} // namespace fast_engine
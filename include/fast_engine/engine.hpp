@@ -4,12 +4,15 @@
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "chess.hpp"
 #include "fast_engine/config.hpp"
+#include "fast_engine/profile.hpp"
 #include "fast_engine/search.hpp"
 #include "fast_engine/transposition.hpp"
 #include "fast_engine/types.hpp"
+#include "fast_engine/worker_thread.hpp"
 
 namespace fast_engine
 {
@@ -38,7 +41,13 @@ namespace fast_engine
         double time_seconds = 0.0;
         double nps = 0.0;
 
-        // Aggregated search stats (over all iterations / re-searches)
+        // Principal variation (UCI move strings, space-separated) for best_move. May be empty.
+        std::string pv_uci;
+
+        // Search threads used (main + Lazy SMP helpers).
+        int threads = 1;
+
+        // Aggregated search stats (over all iterations / re-searches, summed over threads)
         std::uint64_t nodes = 0;
         int depth_requested = 0;
         int depth_reached = 0;
@@ -46,6 +55,7 @@ namespace fast_engine
         std::uint64_t tt_hits = 0;
         std::uint64_t tt_misses = 0;
         double tt_hit_rate = 0.0;
+        std::uint64_t tb_hits = 0;
 
         // Diagnostics (optional):
         // Count of quiet moves that were actually searched at nodes with remaining depth >= 10.
@@ -79,6 +89,10 @@ namespace fast_engine
         std::uint64_t legal_moves_generated = 0;
 
         NeuralAccumulatorStats neural_accumulator{};
+        // Eval-cache and pawn-hash probes, summed over all search threads.
+        EvalCacheStats eval_cache{};
+        // PROFILE=1 builds: per-stage cycle totals summed over all search threads.
+        ProfileCounters profile{};
 
         int aspiration_retries_total = 0;
         int aspiration_fail_lows_total = 0;
@@ -112,6 +126,7 @@ namespace fast_engine
 
         std::uint64_t tt_hits = 0;
         std::uint64_t tt_misses = 0;
+        std::uint64_t tb_hits = 0;
 
         bool is_mate = false;
         bool is_draw = false;
@@ -173,13 +188,27 @@ namespace fast_engine
         Engine();
         explicit Engine(const EngineConfig &cfg);
 
+        // The only way to change the config: it recompiles the eval profile, which the
+        // eval module matches to config_ by address, so in-place edits would go unseen.
         void setConfig(const EngineConfig &cfg);
-        EngineConfig &config() { return config_; }
         const EngineConfig &config() const { return config_; }
 
         void clearTT();
         void resizeTT(std::size_t maxEntries);
         void resizeTT_MB(std::size_t mb);
+        PageMode ttPageMode() const { return tt_.page_mode(); }
+        // Hash snapshot for long analysis sessions: the TT in its in-memory layout, plus the
+        // main thread's histories when include_history. loadHash adopts the saved table
+        // size (config().hash_mb follows it). Call while no search runs; both return false
+        // with `error` set. loadHash returns true once the TT is loaded; if the histories
+        // section is then rejected, `error` says so and the histories are left as they were.
+        bool saveHash(const std::string &path, bool include_history, std::string &error);
+        bool loadHash(const std::string &path, std::string &error);
+
+        // This engine's eval cache and search heuristics (see SearchContext).
+        void clearEvalCache();
+        void resetHeuristics();
+        PageMode evalCachePageMode() const { return context_.eval_cache().page_mode(); }
 
         // Depth-limited search.
         bool search_position(chess::Board &board,
@@ -206,9 +235,40 @@ namespace fast_engine
                                   SearchResult &result,
                                   const IterationCallback &on_iter,
                                   bool keep_searching_at_max_depth);
+        // Pushes eval_cache_mb/pawn_hash_mb to the eval module's caches.
+        void apply_eval_cache_sizes();
+
+        // Where a finished search left its root, so the next search can skip iterations
+        // it already covered. root_ is the searched root itself (a ponder search that
+        // ends in ponderhit restarts on it) with its ordered root moves and PV-stability
+        // state; reply_ is the position two plies down the PV, reached when the opponent
+        // plays the predicted move. Any TT or config change drops both.
+        struct RootCarryover
+        {
+            bool valid = false;
+            std::uint64_t key = 0;
+            int depth = 0;             // completed depth the next search resumes after
+            Score score = 0;           // side-to-move POV, centres the first window
+            Score window = 0;          // aspiration half-width for the first resumed iteration
+            chess::Move best_move{};
+            int pv_change_depth = 0;   // root_ only: depth of the last PV[0] change
+            double time_reduction = 1.0;
+            std::vector<RootMove> root_moves; // root_ only
+        };
+        void drop_carryover() noexcept
+        {
+            carry_root_.valid = false;
+            carry_reply_.valid = false;
+        }
 
         EngineConfig config_;
         TranspositionTable tt_;
+        SearchContext context_;
+        RootCarryover carry_root_{};
+        RootCarryover carry_reply_{};
+        // Lazy SMP helper threads, kept across searches; declared last so they are joined
+        // before the state they search on is destroyed.
+        WorkerPool helpers_;
     };
 
 } // namespace fast_engine
@@ -2,10 +2,15 @@
 
 #include "chess.hpp"
 #include "fast_engine/config.hpp"
+#include "fast_engine/large_pages.hpp"
 #include "fast_engine/types.hpp"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 
 namespace fast_engine
@@ -32,30 +37,242 @@ namespace fast_engine
     Score evaluate_for_side_to_move_with_config(const chess::Board &board,
                                                 const EngineConfig &cfg);
 
-    // Clears the full evaluation cache (used to avoid cross-game cache effects).
-    // This does not affect the TT or other search heuristics.
+    // Largest power-of-two bucket count whose table fits in `mb` megabytes (at least 1).
+    inline std::size_t cache_buckets_for_mb(std::size_t mb, std::size_t bucket_bytes) noexcept
+    {
+        const std::size_t fit = std::max<std::size_t>(1, (std::max<std::size_t>(1, mb) << 20) / bucket_bytes);
+        return std::bit_floor(fit);
+    }
+
+    // Full evaluation cache: the non-tempo White-POV eval keyed by position hash plus the
+    // eval-relevant config bits. One table is shared by all search threads of an engine.
+    // Entries store key ^ data so a torn read from a concurrent store fails validation
+    // instead of returning a foreign score; data packs the score in the low 32 bits and
+    // the generation in bits 32..39.
+    struct EvalCacheEntry
+    {
+        std::uint64_t key_xor_data = 0ULL;
+        std::uint64_t data = 0ULL;
+    };
+
+    constexpr int EVAL_CACHE_CLUSTER_SIZE = 4;
+
+    struct EvalCacheBucket
+    {
+        EvalCacheEntry e[EVAL_CACHE_CLUSTER_SIZE];
+    };
+
+    class EvalCache
+    {
+    public:
+        explicit EvalCache(std::size_t mb = EVAL_CACHE_DEFAULT_MB) { resize_mb(mb); }
+
+        // Drops every entry when the bucket count changes; not safe during a search.
+        void resize_mb(std::size_t mb)
+        {
+            const std::size_t buckets = cache_buckets_for_mb(mb, sizeof(EvalCacheBucket));
+            if (buckets == table_.size())
+                return;
+            table_.assign(buckets, EvalCacheBucket{});
+            mask_ = buckets - 1;
+            gen_ = 1; // generation 0 is reserved for "unused"
+        }
+
+        void clear()
+        {
+            // Bump generation instead of memset'ing the whole table per game.
+            ++gen_;
+            if (gen_ == 0)
+            {
+                // Wrapped: hard clear and restart generations.
+                std::fill(table_.begin(), table_.end(), EvalCacheBucket{});
+                gen_ = 1;
+            }
+        }
+
+        void prefetch(std::uint64_t key) const noexcept
+        {
+            prefetch_address(&table_[static_cast<std::size_t>(key) & mask_]);
+        }
+
+        bool probe(std::uint64_t key, Score &out) const noexcept
+        {
+            const EvalCacheBucket &b = table_[static_cast<std::size_t>(key) & mask_];
+            for (int i = 0; i < EVAL_CACHE_CLUSTER_SIZE; ++i)
+            {
+                const EvalCacheEntry &e = b.e[i];
+                const std::uint64_t data = e.data;
+                if ((e.key_xor_data ^ data) == key &&
+                    static_cast<std::uint8_t>(data >> 32) == gen_)
+                {
+                    out = static_cast<Score>(static_cast<std::int32_t>(static_cast<std::uint32_t>(data)));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void store(std::uint64_t key, Score v) noexcept
+        {
+            EvalCacheBucket &b = table_[static_cast<std::size_t>(key) & mask_];
+
+            // Pseudo-random replacement to avoid hotspots.
+            const int victim = static_cast<int>((key >> 1) & (EVAL_CACHE_CLUSTER_SIZE - 1));
+            EvalCacheEntry &e = b.e[victim];
+            const std::uint64_t data = static_cast<std::uint64_t>(static_cast<std::uint32_t>(v)) |
+                                       (static_cast<std::uint64_t>(gen_) << 32);
+            e.key_xor_data = key ^ data;
+            e.data = data;
+        }
+
+        std::size_t size_bytes() const noexcept { return table_.size() * sizeof(EvalCacheBucket); }
+        PageMode page_mode() const noexcept { return table_.page_mode(); }
+
+    private:
+        LargePageArray<EvalCacheBucket> table_; // tens of MB hot table: worth huge pages
+        std::size_t mask_ = 0;
+        std::uint8_t gen_ = 1;
+    };
+
+    // Evaluation-relevant slice of an EngineConfig, compiled once when the config changes
+    // instead of being re-derived per node: the eval-cache key salt and a mask of the HCE
+    // terms that are switched on. The scales stay in pawn units (doubles) so evaluations
+    // are bit-identical to scoring straight from the config.
+    struct EvalProfile
+    {
+        enum Term : std::uint32_t
+        {
+            KingCrowding = 1u << 0,
+            Mobility = 1u << 1,
+            XrayPins = 1u << 2,
+            Space = 1u << 3,
+            Closedness = 1u << 4,
+            RookActivity = 1u << 5,
+            Threats = 1u << 6,
+            QueenVulnerability = 1u << 7,
+            KingSafety = 1u << 8,
+            BishopPair = 1u << 9,
+            Pst = 1u << 10,
+            StockPst = 1u << 11,
+            EndgameScaling = 1u << 12,
+            Complexity = 1u << 13,
+            AttackMaps = Mobility | Space | Threats | QueenVulnerability | KingSafety
+        };
+
+        // Identifies the config this was compiled from; only compared, never dereferenced.
+        const EngineConfig *source = nullptr;
+        std::uint64_t signature = 0;
+        std::uint32_t terms = 0;
+        EngineConfig::EvalScales scales{};
+
+        bool has(std::uint32_t term) const noexcept { return (terms & term) != 0; }
+    };
+
+    EvalProfile compile_eval_profile(const EngineConfig &cfg);
+
+    // Clears the eval cache the calling thread is bound to, or the process-wide fallback
+    // used by threads that never bound a search context (e.g. a one-off `eval`).
     void clear_eval_cache();
 
+    // Binds the calling thread to HCE cache slot `thread_slot` (pawn hash, material, king
+    // cover; resized to `pawn_hash_mb` if needed) and to the full eval cache `cache`
+    // (nullptr = process-wide fallback), and resets the thread's cache counters. Evaluations
+    // with `profile->source` as their config use the bound profile; any other config (or no
+    // profile) is compiled on the fly.
+    void bind_eval_thread(int thread_slot, EvalCache *cache, std::size_t pawn_hash_mb,
+                          const EvalProfile *profile = nullptr);
+    // Undoes bind_eval_thread when the calling thread is bound to `cache`: it falls back to
+    // the process-wide cache, the reserved slot 0 and on-the-fly profiles. Counters are kept.
+    void unbind_eval_thread(const EvalCache *cache);
+
+    // HCE cache slots are process-wide; each search context leases distinct slot ids for
+    // its threads, so concurrently searching engines never share pawn/material tables.
+    // Slot 0 is reserved for unbound threads and never leased.
+    int acquire_eval_thread_slot();
+    void release_eval_thread_slot(int thread_slot);
+
+    // Eval-cache and pawn-hash probes made by one thread since its last bind.
+    struct EvalCacheStats
+    {
+        std::uint64_t eval_hits = 0;
+        std::uint64_t eval_misses = 0;
+        std::uint64_t pawn_hits = 0;
+        std::uint64_t pawn_misses = 0;
+
+        void add(const EvalCacheStats &other) noexcept
+        {
+            eval_hits += other.eval_hits;
+            eval_misses += other.eval_misses;
+            pawn_hits += other.pawn_hits;
+            pawn_misses += other.pawn_misses;
+        }
+    };
+
+    EvalCacheStats eval_cache_thread_stats();
+
+    // Prefetches the eval-cache bucket (and for HCE the pawn-hash bucket) for `board`.
+    // Search calls it right after making a move so the loads overlap the child's setup.
+    void prefetch_eval_tables(const chess::Board &board, const EngineConfig &cfg);
+
     constexpr int NEURAL_ACCUM_MAX_HIDDEN = 512;
 
     struct NeuralAccumulator
     {
-        alignas(64) std::array<float, NEURAL_ACCUM_MAX_HIDDEN> pre_activation{};
-        alignas(64) std::array<std::int32_t, NEURAL_ACCUM_MAX_HIDDEN> quant_pre_activation{};
-        alignas(64) std::array<std::array<std::int32_t, NEURAL_ACCUM_MAX_HIDDEN>, 2> halfkp_quant_pre_activation{};
+        // Only the active backend's sums are live (see quantized/halfkp), so the per-backend
+        // layouts share one buffer: 4 KB per ply instead of 8 KB for every stack slot,
+        // null-move save and reset.
+        union
+        {
+            alignas(64) std::array<std::array<std::int32_t, NEURAL_ACCUM_MAX_HIDDEN>, 2> halfkp_quant_pre_activation{}; // HalfKP quant: [perspective][hidden]
+            alignas(64) std::array<std::array<std::int16_t, NEURAL_ACCUM_MAX_HIDDEN>, 2> halfkp_quant_pre_activation_i16; // HalfKP quant, int16 lanes (halfkp_i16)
+            alignas(64) std::array<float, NEURAL_ACCUM_MAX_HIDDEN> pre_activation;                                       // Simple768 float
+            alignas(64) std::array<std::int32_t, NEURAL_ACCUM_MAX_HIDDEN> quant_pre_activation;                          // Simple768 quant
+        };
         int hidden_size = 0;
         std::uint64_t board_hash = 0ULL;
         bool quantized = false;
         bool halfkp = false;
+        bool halfkp_i16 = false; // HalfKP sums live in halfkp_quant_pre_activation_i16
         bool valid = false;
     };
 
+    static_assert(sizeof(NeuralAccumulator) <= 2 * NEURAL_ACCUM_MAX_HIDDEN * sizeof(std::int32_t) + 64,
+                  "NeuralAccumulator backends should share storage");
+
     struct NeuralAccumulatorStats
     {
         std::uint64_t refreshes = 0;
         std::uint64_t invalid_fallbacks = 0;
         std::uint64_t delta_updates = 0;
         std::uint64_t check_failures = 0;
+        std::uint64_t king_cache_refreshes = 0; // HalfKP king-move refreshes served from the bucket cache
+        std::uint64_t skipped_updates = 0;      // lazy plies overwritten before anything evaluated them
+    };
+
+    // One piece change of a move: from == NO_SQ adds the piece, to == NO_SQ removes it.
+    struct NeuralDirtyPiece
+    {
+        chess::Piece piece = chess::Piece::NONE;
+        chess::Square from = chess::Square::NO_SQ;
+        chess::Square to = chess::Square::NO_SQ;
+    };
+
+    // Deferred accumulator work for one ply (lazy mode). Search records the move's piece
+    // changes at make time; the accumulator is only built when the node is evaluated.
+    struct NeuralDirtyPieces
+    {
+        std::array<NeuralDirtyPiece, 3> pieces{};
+        int count = 0;
+        std::uint64_t board_hash = 0ULL; // position after the move
+        bool pending = false;            // accumulator for this ply not built yet
+    };
+
+    // Search-owned stacks indexed by ply, with `ply` the node being evaluated.
+    struct NeuralLazyStack
+    {
+        NeuralAccumulator *accums = nullptr;
+        NeuralDirtyPieces *dirty = nullptr;
+        int ply = 0;
     };
 
     // Loads/unloads the stateless Simple768 neural model used by float neural backends.
@@ -79,6 +296,34 @@ namespace fast_engine
     void unload_neural_halfkp_quant_model();
     bool neural_halfkp_quant_model_loaded();
     const std::string &neural_halfkp_quant_model_path();
+    // Binary HalfKP quant models (SKBHKPQB header) are memory-mapped and used in place;
+    // load_neural_halfkp_quant_model detects them by magic. The writer serializes the
+    // currently loaded model, so text -> binary conversion is load + save.
+    bool save_neural_halfkp_quant_model_binary(const std::string &path, std::string &error);
+    // True when the loaded weights come from a mapped binary file (not the embedded net).
+    bool neural_halfkp_quant_model_mapped();
+    // Makes the calling thread read the HalfKP quant w1 block from a copy local to NUMA
+    // node `node` (built on first use by a thread of that node); -1 uses the shared block.
+    // Call after pinning the thread and after any model load.
+    void bind_neural_numa_node(int node);
+    // Offline scoring: raw White-POV HalfKP quant net scores for every board (no eval cache,
+    // KPK or HCE endgame fallback), identical to single-position inference. Positions are
+    // scored in blocks so the hidden layers run as small GEMMs, split across up to `threads`
+    // threads. Every board must pass neural_halfkp_board_supported. Returns false, scoring
+    // nothing, when no HalfKP quant model is loaded, `scores` is too short or a board fails.
+    bool neural_halfkp_board_supported(const chess::Board &board);
+    bool evaluate_batch(std::span<const chess::Board> boards, std::span<Score> scores, int threads = 1);
+    // Directory for shared weight images: text HalfKP quant models are converted once into
+    // a binary image there and mapped, so every process loading the same net shares its
+    // pages. Empty or "<empty>" disables; "auto" picks /dev/shm when present, else the temp
+    // directory. Returns the directory in effect; applies to the next load. Images outlive
+    // the process so later engines reuse them; publishing a model's new image removes that
+    // model's older ones, and `rm <dir>/shakeybot-hkq-*.bin` clears the rest.
+    std::string set_neural_shared_image_dir(const std::string &dir);
+
+    // NeuralModelPath value that selects the network linked in with `make EMBED_NET=...`.
+    inline constexpr const char *EMBEDDED_NEURAL_MODEL_PATH = "<embedded>";
+    bool embedded_neural_halfkp_quant_model_available();
 
     bool neural_accumulator_backend_active(const EngineConfig &cfg) noexcept;
     bool neural_simple_accumulator_matches(const chess::Board &board,
@@ -107,9 +352,24 @@ namespace fast_engine
                                             const EngineConfig &cfg,
                                             NeuralAccumulator &child,
                                             NeuralAccumulatorStats *stats = nullptr);
+    // Lazy mode: false when `move` must still update eagerly (HalfKP king moves rebuild a
+    // perspective from the post-move piece set). Otherwise fills `dirty` (pending, no hash).
+    bool record_neural_dirty_pieces(const chess::Board &board,
+                                    const chess::Move &move,
+                                    const EngineConfig &cfg,
+                                    NeuralDirtyPieces &dirty) noexcept;
+    // Builds lazy.accums[lazy.ply] for `board` by replaying pending plies forward from the
+    // nearest built ancestor; no-op when that ply is already built.
+    void materialize_neural_accumulator(const chess::Board &board,
+                                        const EngineConfig &cfg,
+                                        const NeuralLazyStack &lazy,
+                                        NeuralAccumulatorStats *stats = nullptr);
+    // With `lazy`, `accum` must be lazy.accums[lazy.ply]; it is materialized only on an
+    // eval-cache miss.
     Score evaluate_white_pov_with_accumulator(const chess::Board &board,
                                               const EngineConfig &cfg,
                                               NeuralAccumulator *accum,
-                                              NeuralAccumulatorStats *stats = nullptr);
+                                              NeuralAccumulatorStats *stats = nullptr,
+                                              const NeuralLazyStack *lazy = nullptr);
 
 } // namespace fast_engine
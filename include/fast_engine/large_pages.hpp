@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace fast_engine
+{
+
+    // How a large table ended up being backed by the OS.
+    enum class PageMode : std::uint8_t
+    {
+        Default = 0,         // ordinary pages
+        TransparentHuge = 1, // Linux THP via madvise(MADV_HUGEPAGE)
+        HugeTlb = 2,         // Linux explicit huge pages via mmap(MAP_HUGETLB)
+        WindowsLarge = 3     // Windows VirtualAlloc(MEM_LARGE_PAGES)
+    };
+
+    const char *page_mode_name(PageMode mode) noexcept;
+
+    // Allocates at least `bytes` bytes, preferring huge/large pages and falling back to
+    // ordinary pages. Returned memory is 64-byte aligned but not necessarily zeroed.
+    // Throws std::bad_alloc only if every path fails.
+    void *large_page_alloc(std::size_t bytes, PageMode &mode_out);
+    void large_page_free(void *ptr, std::size_t bytes, PageMode mode) noexcept;
+
+    // Cache-line prefetch hint for a table bucket that is about to be probed.
+    inline void prefetch_address(const void *addr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(addr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char *>(addr), _MM_HINT_T0);
+#else
+        (void)addr;
+#endif
+    }
+
+    // Below this size a single thread zeroes a table faster than spawning workers.
+    constexpr std::size_t PARALLEL_FILL_MIN_BYTES = 32ULL * 1024ULL * 1024ULL;
+
+    // Runs fn(begin, end) over [0, count) in `threads` contiguous slices, one per worker;
+    // the calling thread takes slice 0. Used to zero big tables so each worker
+    // first-touches (and on NUMA systems, places) its own pages.
+    template <typename Fn>
+    void parallel_for_slices(std::size_t count, int threads, Fn &&fn)
+    {
+        const std::size_t workers = std::max<std::size_t>(1, std::min<std::size_t>(static_cast<std::size_t>(std::max(1, threads)), count));
+        const std::size_t chunk = (count + workers - 1) / workers;
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t w = 1; w < workers; ++w)
+        {
+            const std::size_t begin = std::min(count, w * chunk);
+            const std::size_t end = std::min(count, begin + chunk);
+            pool.emplace_back([&fn, begin, end]()
+                              { fn(begin, end); });
+        }
+        fn(std::size_t{0}, std::min(count, chunk));
+        for (std::thread &t : pool)
+            t.join();
+    }
+
+    // Fixed-size array of trivially copyable T on large-page-backed memory.
+    // Replaces std::vector for the TT and the big eval caches.
+    template <typename T>
+    class LargePageArray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "LargePageArray holds trivially copyable buckets");
+
+    public:
+        LargePageArray() = default;
+        ~LargePageArray() { reset(); }
+
+        LargePageArray(const LargePageArray &) = delete;
+        LargePageArray &operator=(const LargePageArray &) = delete;
+
+        LargePageArray(LargePageArray &&other) noexcept
+            : data_(other.data_), size_(other.size_), mode_(other.mode_)
+        {
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.mode_ = PageMode::Default;
+        }
+
+        LargePageArray &operator=(LargePageArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                data_ = other.data_;
+                size_ = other.size_;
+                mode_ = other.mode_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.mode_ = PageMode::Default;
+            }
+            return *this;
+        }
+
+        // Reallocates to `count` elements, each set to `value`. Large arrays are filled
+        // by up to `threads` workers.
+        void assign(std::size_t count, const T &value, int threads = 1)
+        {
+            reset();
+            if (count == 0)
+                return;
+            PageMode mode = PageMode::Default;
+            void *raw = large_page_alloc(count * sizeof(T), mode);
+            data_ = static_cast<T *>(raw);
+            size_ = count;
+            mode_ = mode;
+            T *const base = data_;
+            parallel_for_slices(size_, fill_workers(threads), [base, &value](std::size_t begin, std::size_t end)
+                                { std::uninitialized_fill(base + begin, base + end, value); });
+        }
+
+        // Worker count worth using to touch this array; 1 for small tables.
+        int fill_workers(int threads) const noexcept
+        {
+            return size_ * sizeof(T) >= PARALLEL_FILL_MIN_BYTES ? std::max(1, threads) : 1;
+        }
+
+        void reset() noexcept
+        {
+            if (data_)
+                large_page_free(data_, size_ * sizeof(T), mode_);
+            data_ = nullptr;
+            size_ = 0;
+            mode_ = PageMode::Default;
+        }
+
+        T &operator[](std::size_t i) noexcept { return data_[i]; }
+        const T &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        T *data() noexcept { return data_; }
+        const T *data() const noexcept { return data_; }
+        T *begin() noexcept { return data_; }
+        T *end() noexcept { return data_ + size_; }
+        const T *begin() const noexcept { return data_; }
+        const T *end() const noexcept { return data_ + size_; }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        PageMode page_mode() const noexcept { return mode_; }
+
+    private:
+        T *data_ = nullptr;
+        std::size_t size_ = 0;
+        PageMode mode_ = PageMode::Default;
+    };
+
+} // namespace fast_engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace fast_engine
+{
+
+    // Read-only memory mapping of a whole file. Binary NNUE models are served straight
+    // out of the mapping, so the OS page cache backs the weights and startup does no parsing.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // Maps `path`; on failure returns false with `error` set and leaves the object closed.
+        bool open(const std::string &path, std::string &error);
+        void close() noexcept;
+
+        const unsigned char *data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        bool is_open() const noexcept { return data_ != nullptr; }
+
+    private:
+        const unsigned char *data_ = nullptr;
+        std::size_t size_ = 0;
+#ifdef _WIN32
+        void *file_ = nullptr;
+        void *mapping_ = nullptr;
+#endif
+    };
+
+} // namespace fast_engine
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "fast_engine/config.hpp"
+
+namespace fast_engine
+{
+
+    const char *numa_policy_name(NumaPolicy policy) noexcept;
+    // Accepts "none" and "auto"; returns false for anything else.
+    bool parse_numa_policy(const std::string &name, NumaPolicy &out) noexcept;
+
+    // Memory nodes with CPUs, read once from /sys/devices/system/node on Linux. Other
+    // platforms and single-node machines report 1.
+    int numa_node_count() noexcept;
+
+    // Node that search thread `thread_index` of `thread_count` runs on under `policy`, or -1
+    // when threads stay unpinned (NumaPolicy::None, or only one node). Threads fill nodes in
+    // contiguous blocks, so the main thread and the first helpers share node 0.
+    int numa_node_for_thread(NumaPolicy policy, int thread_index, int thread_count) noexcept;
+
+    // Restricts the calling thread to the CPUs of `node`; -1 restores the process affinity
+    // it started with. A no-op when the thread is already there. Returns false when the
+    // platform or the node does not support it.
+    bool numa_bind_current_thread(int node) noexcept;
+
+} // namespace fast_engine
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Opt-in hot-path stage timers. `make PROFILE=1` defines SHAKEYBOT_PROFILE=1; every
+// SHAKEYBOT_PROFILE_SCOPE then reads the cycle counter on entry and exit and adds the
+// difference to thread-local per-stage totals. In normal builds the macro expands to
+// nothing and the counters stay zero.
+
+#ifndef SHAKEYBOT_PROFILE
+#define SHAKEYBOT_PROFILE 0
+#endif
+
+#if SHAKEYBOT_PROFILE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace fast_engine
+{
+
+    enum class ProfileStage : int
+    {
+        HceEval = 0,  // evaluate_hce_white_pov_uncached
+        NnueUpdate,   // incremental accumulator update (eager move or lazy replay)
+        NnueRefresh,  // full accumulator refresh
+        NnueOutput,   // output layers from a built accumulator
+        See,          // see_cp
+        MoveScoring,  // MovePicker stage scoring
+        TtProbe,      // TranspositionTable::probe
+        TtStore,      // TranspositionTable::store
+        LegalMovegen, // chess::movegen::legalmoves from search
+        Count
+    };
+
+    constexpr int PROFILE_STAGE_COUNT = static_cast<int>(ProfileStage::Count);
+    constexpr bool PROFILE_ENABLED = SHAKEYBOT_PROFILE != 0;
+
+    // Short stage names used in "[GO]" debug keys and bench output.
+    constexpr std::array<const char *, PROFILE_STAGE_COUNT> PROFILE_STAGE_NAMES = {
+        "HceEval", "NnUpdate", "NnRefresh", "NnOutput", "See", "MoveScore", "TtProbe", "TtStore", "LegalGen"};
+
+    // Inclusive cycle totals and call counts per stage (nested stages count in both).
+    struct ProfileCounters
+    {
+        std::array<std::uint64_t, PROFILE_STAGE_COUNT> cycles{};
+        std::array<std::uint64_t, PROFILE_STAGE_COUNT> calls{};
+
+        void add(const ProfileCounters &other) noexcept
+        {
+            for (int i = 0; i < PROFILE_STAGE_COUNT; ++i)
+            {
+                cycles[static_cast<std::size_t>(i)] += other.cycles[static_cast<std::size_t>(i)];
+                calls[static_cast<std::size_t>(i)] += other.calls[static_cast<std::size_t>(i)];
+            }
+        }
+    };
+
+#if SHAKEYBOT_PROFILE
+    inline thread_local ProfileCounters g_profile_counters{};
+
+    inline std::uint64_t profile_timestamp() noexcept
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(ProfileStage stage) noexcept
+            : stage_(static_cast<std::size_t>(stage)), start_(profile_timestamp())
+        {
+        }
+
+        ~ProfileScope()
+        {
+            g_profile_counters.cycles[stage_] += profile_timestamp() - start_;
+            ++g_profile_counters.calls[stage_];
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        std::size_t stage_;
+        std::uint64_t start_;
+    };
+
+#define SHAKEYBOT_PROFILE_CAT2(a, b) a##b
+#define SHAKEYBOT_PROFILE_CAT(a, b) SHAKEYBOT_PROFILE_CAT2(a, b)
+#define SHAKEYBOT_PROFILE_SCOPE(stage) \
+    const ::fast_engine::ProfileScope SHAKEYBOT_PROFILE_CAT(shakeybot_profile_scope_, __LINE__)(stage)
+
+    inline void profile_reset_thread_counters() noexcept { g_profile_counters = ProfileCounters{}; }
+    inline ProfileCounters profile_thread_counters() noexcept { return g_profile_counters; }
+#else
+#define SHAKEYBOT_PROFILE_SCOPE(stage) static_cast<void>(0)
+
+    inline void profile_reset_thread_counters() noexcept {}
+    inline ProfileCounters profile_thread_counters() noexcept { return ProfileCounters{}; }
+#endif
+
+} // namespace fast_engine
@@ -2,7 +2,11 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "chess.hpp"
@@ -25,6 +29,7 @@ namespace fast_engine
 
         std::uint64_t tt_hits = 0;
         std::uint64_t tt_misses = 0;
+        std::uint64_t tb_hits = 0; // interior Syzygy WDL probes that returned a result
 
         int root_branching_factor = 0;
 
@@ -163,5 +168,62 @@ namespace fast_engine
                         Score beta = SEARCH_INF,
                         SearchControl *control = nullptr);
 
+    // Everything an Engine's search threads mutate besides the TT: per-thread histories,
+    // killers and stacks, the HCE cache slots leased for those threads, and the full eval
+    // cache. Engines with separate contexts can search concurrently; models and lookup
+    // tables are read-only and stay process-wide.
+    class SearchContext
+    {
+    public:
+        explicit SearchContext(std::size_t eval_cache_mb = EVAL_CACHE_DEFAULT_MB,
+                               std::size_t pawn_hash_mb = PAWN_HASH_DEFAULT_MB);
+        ~SearchContext();
+
+        SearchContext(const SearchContext &) = delete;
+        SearchContext &operator=(const SearchContext &) = delete;
+
+        // Binds the calling thread to slot thread_index (0 = main search thread, 1.. = Lazy
+        // SMP helpers). Slots persist across searches so history tables carry over between
+        // moves. With numa_node >= 0 (the thread is pinned there) a slot built on another
+        // node is copied into memory this thread first-touches, and HalfKP weights are read
+        // from that node's replica.
+        void bind_thread(int thread_index, int numa_node = -1);
+        // Drops the calling thread's bindings to this context, if any, so nothing on that
+        // thread points into the context once it is rebuilt or destroyed. Engine searches
+        // bind for their own scope; the destructor unbinds the destroying thread.
+        void unbind_thread();
+
+        // Clears history/killer/counter tables and search stacks in every slot.
+        void reset_heuristics();
+
+        // Heuristics snapshot of slot 0 (the main thread), appended to a TT snapshot by
+        // savehash: 8-byte magic "SKBHIST1", u32 version, u32 table count, per table u32
+        // element bytes and u64 bytes, then the butterfly, continuation, capture, pawn and
+        // piece-continuation histories, counter moves, correction history and killers in
+        // native layout. Another version or any table layout differing from this build's is
+        // rejected without touching the tables. Both return false with `error` set.
+        bool write_heuristics(std::ostream &out, std::string &error);
+        bool read_heuristics(std::istream &in, std::string &error);
+
+        EvalCache &eval_cache() noexcept { return eval_cache_; }
+        const EvalCache &eval_cache() const noexcept { return eval_cache_; }
+
+        // Pawn hash size per thread; applied when a thread next binds.
+        void set_pawn_hash_mb(std::size_t mb) noexcept { pawn_hash_mb_ = mb < 1 ? 1 : mb; }
+        // Eval profile of the engine config; applied when a thread next binds.
+        void set_eval_profile(const EvalProfile &profile) noexcept { eval_profile_ = profile; }
+
+        struct Impl;
+
+    private:
+        std::unique_ptr<Impl> impl_;
+        EvalCache eval_cache_;
+        std::size_t pawn_hash_mb_;
+        EvalProfile eval_profile_{};
+    };
+
+    // Process-wide default context, for callers that drive find_best_move() directly;
+    // threads that never bind share its slot 0.
+    void bind_search_thread(int thread_index);
     void reset_search_heuristics();
 } // namespace fast_engine
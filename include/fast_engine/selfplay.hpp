@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "fast_engine/config.hpp"
+
+namespace fast_engine
+{
+
+    // In-process game driver for tuning: plays `games` games between two configs (the same
+    // config twice for selfplay) on `threads` worker threads. Each worker owns one Engine
+    // per side, so games share only the read-only models loaded beforehand.
+    struct SelfplayOptions
+    {
+        int games = 100;
+        int threads = 1;         // concurrent games
+        int depth = 6;           // fixed search depth per move (used when movetime_ms <= 0)
+        int movetime_ms = -1;    // fixed time per move
+        int random_plies = 8;    // random legal plies after the opening position
+        int max_plies = 400;     // longer games are adjudicated as draws
+        std::uint64_t seed = 1;  // drives the random opening plies
+        int hash_mb = 16;        // TT per engine
+        std::vector<std::string> openings; // start FENs, cycled per game pair; empty = startpos
+        std::string log_path;              // binary game log; empty = none
+        EngineConfig config[2];            // [0] = engine A, [1] = engine B
+    };
+
+    enum class SelfplayResult : std::uint8_t
+    {
+        WhiteWin = 0,
+        Draw = 1,
+        BlackWin = 2
+    };
+
+    struct SelfplayGame
+    {
+        int index = 0;
+        bool a_is_white = true;
+        SelfplayResult result = SelfplayResult::Draw;
+        std::string start_fen;            // position after the random opening plies
+        std::vector<std::uint16_t> moves; // chess::Move::move() encoding
+        std::vector<std::int16_t> scores; // White-POV centipawns per move
+        std::uint64_t nodes = 0;
+    };
+
+    struct SelfplaySummary
+    {
+        int games = 0;
+        int a_wins = 0;
+        int b_wins = 0;
+        int draws = 0;
+        std::uint64_t plies = 0;
+        std::uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    // Binary game log: the 8-byte magic "SKBGAME1", then one record per finished game in
+    // completion order, all integers little-endian:
+    //   u32 game index, u8 result (SelfplayResult), u8 flags (bit 0: engine A had White),
+    //   u16 FEN length, FEN bytes, u16 ply count, then per ply u16 move + i16 score.
+    inline constexpr char SELFPLAY_LOG_MAGIC[8] = {'S', 'K', 'B', 'G', 'A', 'M', 'E', '1'};
+
+    // Called once per finished game from the worker that played it (calls are serialized).
+    using SelfplayGameCallback = std::function<void(const SelfplayGame &game)>;
+
+    // Returns false with `error` set only when the log cannot be opened.
+    bool run_selfplay(const SelfplayOptions &options,
+                      SelfplaySummary &summary,
+                      std::string &error,
+                      const SelfplayGameCallback &on_game = {});
+
+} // namespace fast_engine
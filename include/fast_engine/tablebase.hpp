@@ -36,4 +36,13 @@ namespace fast_engine
                                           const EngineConfig &config);
     bool initialize_syzygy(const EngineConfig &config);
 
+    // Largest piece count covered by the loaded tables (0 when none are loaded).
+    int syzygy_max_pieces() noexcept;
+
+    // Interior-node WDL probe. Callers gate on piece count, castling rights and a zero
+    // 50-move counter (Fathom's WDL tables assume it). Lock-free: Fathom's WDL probe is
+    // thread-safe once the tables are loaded, and each thread keeps a small cache of
+    // results keyed by the Zobrist hash. The path must not change while a search runs.
+    bool probe_syzygy_wdl(const chess::Board &board, TablebaseWdl &wdl) noexcept;
+
 } // namespace fast_engine
@@ -3,10 +3,13 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <iosfwd>
 #include <optional>
-#include <vector>
+#include <string>
+#include <thread>
 
 #include "chess.hpp"
+#include "fast_engine/large_pages.hpp"
 #include "fast_engine/types.hpp"
 
 namespace fast_engine
@@ -19,6 +22,17 @@ namespace fast_engine
         TT_UPPERBOUND
     };
     constexpr Score TT_NO_STATIC_EVAL = SCORE_INF;
+    // Largest table the UCI Hash option offers; snapshots claiming more are rejected.
+    inline constexpr std::size_t TT_MAX_MB = 4096;
+
+    // TT snapshot (savehash/loadhash): a 48-byte header, then the bucket array exactly as
+    // it sits in memory, so a reload is one sequential read.
+    //   8-byte magic "SKBTTAB1", u32 version, u32 byte-order tag 0x01020304,
+    //   u32 entry bytes, u32 cluster size, u64 bucket count, u8 gen, u8 clear_gen,
+    //   6 bytes zero, u64 FNV-1a of the preceding 40 bytes.
+    // Entries are stored in native byte order; the tag rejects files from the other one.
+    inline constexpr char TT_SNAPSHOT_MAGIC[8] = {'S', 'K', 'B', 'T', 'T', 'A', 'B', '1'};
+    inline constexpr std::uint32_t TT_SNAPSHOT_VERSION = 1;
 
     struct TTEntry
     {
@@ -49,61 +63,121 @@ namespace fast_engine
 
         TranspositionTable() = default;
         explicit TranspositionTable(std::size_t maxEntries) { resize(maxEntries); }
+        ~TranspositionTable();
+
+        TranspositionTable(const TranspositionTable &) = delete;
+        TranspositionTable &operator=(const TranspositionTable &) = delete;
 
         void resize(std::size_t maxEntries);
+        // Zeroing on resize and generation wrap is split across this many threads.
+        void set_fill_threads(int threads) { fill_threads_ = std::max(1, threads); }
+        // Call while idle (after a search): when the 8-bit generation is about to wrap,
+        // the table is wiped on a background thread instead of inside the next search.
+        void schedule_wrap_clear();
         void clear();      // O(1): bump generation
         void new_search(); // bump generation, keep older entries probeable
 
         std::optional<TTEntry> probe(std::uint64_t key) const;
+        // Starts loading the bucket for `key`; call as soon as the child key is known.
+        void prefetch(std::uint64_t key) const noexcept
+        {
+            if (!table_.empty())
+                prefetch_address(&table_[static_cast<std::size_t>(key) & mask_]);
+        }
         void store(const TTEntry &entry);
         static std::size_t entries_for_mb(std::size_t mb);
         static std::size_t mb_for_entries(std::size_t entries);
         std::size_t capacity() const { return capacity_entries_; }
+        // Snapshot I/O in the layout above; call while no search runs. read_snapshot resizes
+        // the table to the saved bucket count and restores the generation counters. Both
+        // return false with `error` set. A rejected header (including a bucket count above
+        // TT_MAX_MB or one a seekable stream cannot hold) leaves the table untouched; a
+        // payload that still comes up short leaves it cleared.
+        bool write_snapshot(std::ostream &out, std::string &error);
+        bool read_snapshot(std::istream &in, std::string &error);
+        PageMode page_mode() const { return table_.page_mode(); }
 
         // Stored bytes per packed TT entry, used for MB sizing.
         static constexpr std::size_t stored_entry_bytes() { return sizeof(PackedEntry); }
 
     private:
-        // Compact entry stored in the main TT array.
+        // Compact entry stored in the main TT array as two 64-bit words so concurrent
+        // search threads can probe and store without locks:
+        //   data = value_cp (low 32) | static_eval_cp (high 32)
+        //   meta = key32 ^ fold(data) (low 32) | move16 | depth_flag | gen
+        // Each word is accessed atomically (relaxed). A reader that sees words from two
+        // different stores fails the key check, so torn entries are treated as misses.
         struct PackedEntry
         {
-            std::int32_t value_cp = 0;                // centipawns, already mate-adjusted
-            std::int32_t static_eval_cp = TT_NO_STATIC_EVAL; // raw static eval or sentinel
-            std::uint32_t key32 = 0;                  // key signature (top bits)
-            std::uint16_t move16 = 0;                 // chess::Move raw (0 == NO_MOVE)
-            std::uint8_t depth_flag = 0xFF; // low 6 bits depth, high 2 bits TTFlag, 0xFF == empty
-            std::uint8_t gen = 0;                    // generation tag
+            std::uint64_t data = pack_data(0, TT_NO_STATIC_EVAL);
+            std::uint64_t meta = pack_meta(0, chess::Move::NO_MOVE, 0xFF, 0); // depth_flag 0xFF == empty
         };
 
         static_assert(sizeof(PackedEntry) == 16, "PackedEntry should be 16 bytes");
 
+        // Decoded copy of a PackedEntry, taken from one validated load.
+        struct EntryView
+        {
+            std::int32_t value_cp = 0;                       // centipawns, already mate-adjusted
+            std::int32_t static_eval_cp = TT_NO_STATIC_EVAL; // raw static eval or sentinel
+            std::uint32_t key32 = 0;                         // key signature (top bits); garbage if torn
+            std::uint16_t move16 = 0;                        // chess::Move raw (0 == NO_MOVE)
+            std::uint8_t depth_flag = 0xFF;                  // low 6 bits depth, high 2 bits TTFlag, 0xFF == empty
+            std::uint8_t gen = 0;                            // generation tag
+        };
+
         struct Bucket
         {
             std::array<PackedEntry, CLUSTER_SIZE> e{};
         };
 
-        std::vector<Bucket> table_{};
+        LargePageArray<Bucket> table_{}; // huge-page backed when the OS allows it
         std::size_t mask_ = 0;             // bucket index mask (power-of-two)
         std::size_t capacity_entries_ = 0; // buckets * CLUSTER_SIZE
         std::uint8_t gen_ = 1;
         std::uint8_t clear_gen_ = 1;
+        int fill_threads_ = 1;
+        std::thread wrap_clear_thread_{}; // background wipe; joined before gen_ changes
 
         static std::uint32_t key_signature32(std::uint64_t key)
         {
             return static_cast<std::uint32_t>(key >> 32);
         }
 
-        static bool entry_empty(const PackedEntry &entry)
+        static constexpr std::uint64_t pack_data(std::int32_t value_cp, std::int32_t static_eval_cp)
+        {
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(value_cp)) |
+                   (static_cast<std::uint64_t>(static_cast<std::uint32_t>(static_eval_cp)) << 32);
+        }
+
+        static constexpr std::uint32_t fold_data(std::uint64_t data)
+        {
+            return static_cast<std::uint32_t>(data) ^ static_cast<std::uint32_t>(data >> 32);
+        }
+
+        static constexpr std::uint64_t pack_meta(std::uint32_t key32_xor, std::uint16_t move16,
+                                                 std::uint8_t depth_flag, std::uint8_t gen)
+        {
+            return static_cast<std::uint64_t>(key32_xor) |
+                   (static_cast<std::uint64_t>(move16) << 32) |
+                   (static_cast<std::uint64_t>(depth_flag) << 48) |
+                   (static_cast<std::uint64_t>(gen) << 56);
+        }
+
+        static EntryView load_entry(const PackedEntry &packed);
+        static void store_entry(PackedEntry &packed, const EntryView &view);
+
+        static bool entry_empty(const EntryView &entry)
         {
             return entry.depth_flag == 0xFF;
         }
 
-        static int entry_depth(const PackedEntry &entry)
+        static int entry_depth(const EntryView &entry)
         {
             return static_cast<int>(entry.depth_flag & 0x3F);
         }
 
-        static TTFlag entry_flag(const PackedEntry &entry)
+        static TTFlag entry_flag(const EntryView &entry)
         {
             return static_cast<TTFlag>(entry.depth_flag >> 6);
         }
@@ -116,6 +190,8 @@ namespace fast_engine
 
         bool generation_valid(std::uint8_t gen) const;
         void hard_clear();
+        void wipe_entries();
+        void finish_wrap_clear();
         void advance_generation();
     };
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fast_engine
+{
+
+    // One persistent thread that runs submitted jobs one at a time. Searches reuse it
+    // instead of creating a std::thread per "go" or per helper; an idle worker sleeps
+    // on a condition variable.
+    class WorkerThread
+    {
+    public:
+        WorkerThread();
+        ~WorkerThread();
+
+        WorkerThread(const WorkerThread &) = delete;
+        WorkerThread &operator=(const WorkerThread &) = delete;
+
+        // Waits for any running job, then starts `job` on the worker.
+        void start(std::function<void()> job);
+        // Blocks until the current job (if any) has returned.
+        void wait();
+        bool busy() const;
+
+    private:
+        void loop();
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::function<void()> job_;
+        bool busy_ = false;
+        bool quit_ = false;
+        std::thread thread_;
+    };
+
+    // Grow-only set of WorkerThreads; Lazy SMP helpers keep their threads across searches.
+    class WorkerPool
+    {
+    public:
+        // Ensures at least `count` workers exist.
+        void reserve(int count);
+        int size() const noexcept { return static_cast<int>(workers_.size()); }
+
+        void start(int index, std::function<void()> job) { workers_[static_cast<std::size_t>(index)]->start(std::move(job)); }
+        void wait_all();
+
+    private:
+        std::vector<std::unique_ptr<WorkerThread>> workers_;
+    };
+
+} // namespace fast_engine
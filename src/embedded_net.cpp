@@ -0,0 +1,48 @@
+#include "fast_engine/embedded_net.hpp"
+
+// SHAKEYBOT_EMBEDDED_NET_FILE is set by the Makefile's EMBED_NET option to the absolute
+// path of a binary model (see halfkp_convert). The assembler copies the file into
+// read-only data, 64-byte aligned so the weight blocks are used in place.
+
+#if defined(SHAKEYBOT_EMBEDDED_NET_FILE)
+
+#define SHAKEYBOT_EMBED_STR2(x) #x
+#define SHAKEYBOT_EMBED_STR(x) SHAKEYBOT_EMBED_STR2(x)
+#define SHAKEYBOT_EMBED_SYMBOL(name) SHAKEYBOT_EMBED_STR(__USER_LABEL_PREFIX__) #name
+
+#if defined(_WIN32)
+#define SHAKEYBOT_EMBED_SECTION ".rdata,\"dr\""
+#elif defined(__APPLE__)
+#define SHAKEYBOT_EMBED_SECTION "__DATA,__const"
+#else
+#define SHAKEYBOT_EMBED_SECTION ".rodata"
+#endif
+
+asm(".pushsection " SHAKEYBOT_EMBED_SECTION "\n"
+    ".balign 64\n"
+    ".globl " SHAKEYBOT_EMBED_SYMBOL(shakeybot_embedded_net_begin) "\n"
+    SHAKEYBOT_EMBED_SYMBOL(shakeybot_embedded_net_begin) ":\n"
+    ".incbin \"" SHAKEYBOT_EMBEDDED_NET_FILE "\"\n"
+    ".globl " SHAKEYBOT_EMBED_SYMBOL(shakeybot_embedded_net_end) "\n"
+    SHAKEYBOT_EMBED_SYMBOL(shakeybot_embedded_net_end) ":\n"
+    ".popsection\n");
+
+extern "C" const unsigned char shakeybot_embedded_net_begin[];
+extern "C" const unsigned char shakeybot_embedded_net_end[];
+
+#endif
+
+namespace fast_engine
+{
+
+    EmbeddedNet embedded_net() noexcept
+    {
+#if defined(SHAKEYBOT_EMBEDDED_NET_FILE)
+        return EmbeddedNet{shakeybot_embedded_net_begin,
+                           static_cast<std::size_t>(shakeybot_embedded_net_end - shakeybot_embedded_net_begin)};
+#else
+        return EmbeddedNet{};
+#endif
+    }
+
+} // namespace fast_engine
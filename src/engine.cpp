@@ -1,17 +1,34 @@
 #include <chrono>
 #include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <sstream>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "fast_engine/engine.hpp"
+#include "fast_engine/numa.hpp"
 
 namespace fast_engine
 {
 
     namespace
     {
+        // Binds the calling thread to a search context for one search and unbinds it on exit,
+        // so no thread keeps pointers into an engine that is destroyed or rebinds its slots.
+        struct ScopedSearchBinding
+        {
+            SearchContext &context;
+            ScopedSearchBinding(SearchContext &ctx, int thread_index, int numa_node) : context(ctx)
+            {
+                context.bind_thread(thread_index, numa_node);
+            }
+            ~ScopedSearchBinding() { context.unbind_thread(); }
+            ScopedSearchBinding(const ScopedSearchBinding &) = delete;
+            ScopedSearchBinding &operator=(const ScopedSearchBinding &) = delete;
+        };
+
         struct RootIterationTelemetry
         {
             int aspiration_retries = 0;
@@ -347,6 +364,25 @@ namespace fast_engine
         return chess::Move::NO_MOVE;
     }
 
+    // Follows the TT PV two plies from `line` (our move, then the predicted reply) and
+    // returns our PV move in the position reached, or NO_MOVE when the line breaks.
+    static chess::Move predicted_line_move(chess::Board &line,
+                                           const TranspositionTable &tt,
+                                           chess::Move root_best)
+    {
+        if (root_best == chess::Move::NO_MOVE || !is_legal_move(line, root_best))
+            return chess::Move::NO_MOVE;
+        line.makeMove(root_best);
+        const chess::Move reply = probe_root_tt_move(line, tt);
+        if (reply == chess::Move::NO_MOVE || !is_legal_move(line, reply))
+            return chess::Move::NO_MOVE;
+        line.makeMove(reply);
+        const chess::Move next = probe_root_tt_move(line, tt);
+        if (next == chess::Move::NO_MOVE || !is_legal_move(line, next))
+            return chess::Move::NO_MOVE;
+        return next;
+    }
+
     static void reorder_root_moves(std::vector<RootMove> &root_moves,
                                    chess::Move pv_move,
                                    chess::Move tt_move,
@@ -393,41 +429,231 @@ namespace fast_engine
         }
     }
 
+    static void accumulate_search_counters(SearchStats &total, const SearchStats &iter)
+    {
+        total.nodes += iter.nodes;
+        total.tt_hits += iter.tt_hits;
+        total.tt_misses += iter.tt_misses;
+        total.tb_hits += iter.tb_hits;
+        total.quiet_searched_ge10 += iter.quiet_searched_ge10;
+        total.quiet_researched_ge10 += iter.quiet_researched_ge10;
+        total.badcap_nodes += iter.badcap_nodes;
+        total.badcap_picked += iter.badcap_picked;
+        total.badcap_searched += iter.badcap_searched;
+        total.badcap_gen_nodes += iter.badcap_gen_nodes;
+        total.badcap_generated += iter.badcap_generated;
+        total.razor_attempts += iter.razor_attempts;
+        total.razor_cutoffs += iter.razor_cutoffs;
+        total.probcut_nodes += iter.probcut_nodes;
+        total.probcut_candidates += iter.probcut_candidates;
+        total.probcut_see_rejects += iter.probcut_see_rejects;
+        total.probcut_qs_passes += iter.probcut_qs_passes;
+        total.probcut_searches += iter.probcut_searches;
+        total.probcut_cutoffs += iter.probcut_cutoffs;
+        total.legal_movegen_calls += iter.legal_movegen_calls;
+        total.legal_moves_generated += iter.legal_moves_generated;
+        total.neural_accumulator.refreshes += iter.neural_accumulator.refreshes;
+        total.neural_accumulator.invalid_fallbacks += iter.neural_accumulator.invalid_fallbacks;
+        total.neural_accumulator.delta_updates += iter.neural_accumulator.delta_updates;
+        total.neural_accumulator.check_failures += iter.neural_accumulator.check_failures;
+        total.neural_accumulator.king_cache_refreshes += iter.neural_accumulator.king_cache_refreshes;
+        total.neural_accumulator.skipped_updates += iter.neural_accumulator.skipped_updates;
+    }
+
+    // Lazy SMP helper: an independent full-window iterative deepening loop on its own
+    // per-thread heuristics, sharing only the TT with the main thread. Helpers skip
+    // depths in staggered blocks so threads spread over neighbouring root depths
+    // instead of racing through the same iteration.
+    struct HelperSearchOutcome
+    {
+        SearchStats stats{};
+        ProfileCounters profile{};
+        EvalCacheStats eval_cache{};
+        chess::Move best_move{};
+        Score score = 0;
+        int depth = 0;
+        bool has_best = false;
+    };
+
+    // Shallower carried-over state is not worth resuming from; re-searching it is cheap.
+    constexpr int CARRYOVER_MIN_DEPTH = 4;
+
+    constexpr int HELPER_SKIP_PATTERNS = 20;
+    constexpr int HELPER_SKIP_SIZE[HELPER_SKIP_PATTERNS] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    constexpr int HELPER_SKIP_PHASE[HELPER_SKIP_PATTERNS] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    static void run_helper_search(SearchContext &context,
+                                  int thread_index,
+                                  int numa_node,
+                                  chess::Board board,
+                                  int start_depth,
+                                  int max_depth,
+                                  const EngineConfig &config,
+                                  TranspositionTable &tt,
+                                  std::atomic<bool> &stop,
+                                  std::atomic<std::uint64_t> &shared_nodes,
+                                  HelperSearchOutcome &out)
+    {
+        numa_bind_current_thread(numa_node);
+        const ScopedSearchBinding binding(context, thread_index, numa_node);
+        profile_reset_thread_counters();
+
+        SearchControl control{};
+        control.start = std::chrono::steady_clock::now();
+        control.external_stop = &stop;
+
+        const int pattern = (thread_index - 1) % HELPER_SKIP_PATTERNS;
+        std::vector<RootMove> root_moves;
+        for (int depth = start_depth; depth <= max_depth; ++depth)
+        {
+            if (stop.load(std::memory_order_relaxed))
+                break;
+            if (depth > start_depth && ((depth + HELPER_SKIP_PHASE[pattern]) / HELPER_SKIP_SIZE[pattern]) % 2 != 0)
+                continue;
+
+            SearchStats iter_stats{};
+            iter_stats.depth_requested = depth;
+            chess::Move iter_best_move{};
+            Score iter_best_score = 0;
+            const bool ok = find_best_move(board,
+                                           depth,
+                                           config,
+                                           config.use_quiescence,
+                                           /*allow_iid=*/true,
+                                           tt,
+                                           &root_moves,
+                                           iter_stats,
+                                           iter_best_move,
+                                           iter_best_score,
+                                           -SEARCH_INF,
+                                           SEARCH_INF,
+                                           &control);
+
+            accumulate_search_counters(out.stats, iter_stats);
+            shared_nodes.fetch_add(iter_stats.nodes, std::memory_order_relaxed);
+            if (!ok || iter_stats.stopped)
+                break;
+
+            out.best_move = iter_best_move;
+            out.score = iter_best_score;
+            out.depth = depth;
+            out.has_best = iter_stats.has_best_move;
+            reorder_root_moves(root_moves, iter_best_move, probe_root_tt_move(board, tt), /*use_last_scores=*/true);
+            commit_root_iteration(root_moves);
+        }
+        out.profile = profile_thread_counters();
+        out.eval_cache = eval_cache_thread_stats();
+    }
+
     Engine::Engine()
         : config_(),
-          tt_()
+          tt_(),
+          context_(static_cast<std::size_t>(std::max(1, config_.eval_cache_mb)),
+                   static_cast<std::size_t>(std::max(1, config_.pawn_hash_mb)))
     {
+        context_.set_eval_profile(compile_eval_profile(config_));
         resizeTT_MB(static_cast<std::size_t>(config_.hash_mb));
     }
 
     Engine::Engine(const EngineConfig &cfg)
         : config_(cfg),
-          tt_()
+          tt_(),
+          context_(static_cast<std::size_t>(std::max(1, config_.eval_cache_mb)),
+                   static_cast<std::size_t>(std::max(1, config_.pawn_hash_mb)))
     {
+        context_.set_eval_profile(compile_eval_profile(config_));
         resizeTT_MB(static_cast<std::size_t>(config_.hash_mb));
     }
 
     void Engine::setConfig(const EngineConfig &cfg)
     {
         config_ = cfg;
+        drop_carryover();
+        context_.set_eval_profile(compile_eval_profile(config_));
+        tt_.set_fill_threads(config_.threads);
+        apply_eval_cache_sizes();
+    }
+
+    // Both are no-ops when the size is unchanged, so this is cheap per setoption.
+    void Engine::apply_eval_cache_sizes()
+    {
+        context_.eval_cache().resize_mb(static_cast<std::size_t>(std::max(1, config_.eval_cache_mb)));
+        context_.set_pawn_hash_mb(static_cast<std::size_t>(std::max(1, config_.pawn_hash_mb)));
+    }
+
+    void Engine::clearEvalCache()
+    {
+        context_.eval_cache().clear();
+    }
+
+    void Engine::resetHeuristics()
+    {
+        drop_carryover();
+        context_.reset_heuristics();
     }
 
     void Engine::clearTT()
     {
+        drop_carryover();
         tt_.clear();
     }
 
     void Engine::resizeTT(std::size_t maxEntries)
     {
+        drop_carryover();
+        tt_.set_fill_threads(config_.threads);
         tt_.resize(maxEntries);
     }
     void Engine::resizeTT_MB(std::size_t mb)
     {
         if (mb < 1)
             mb = 1;
+        drop_carryover();
         config_.hash_mb = static_cast<int>(mb);
+        tt_.set_fill_threads(config_.threads);
         tt_.resize(TranspositionTable::entries_for_mb(mb));
     }
+    bool Engine::saveHash(const std::string &path, bool include_history, std::string &error)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        if (!tt_.write_snapshot(out, error))
+            return false;
+        if (include_history && !context_.write_heuristics(out, error))
+            return false;
+        out.close();
+        if (!out)
+        {
+            error = "write failed";
+            return false;
+        }
+        return true;
+    }
+
+    bool Engine::loadHash(const std::string &path, std::string &error)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+        drop_carryover();
+        tt_.set_fill_threads(config_.threads);
+        const bool loaded = tt_.read_snapshot(in, error);
+        config_.hash_mb = static_cast<int>(TranspositionTable::mb_for_entries(tt_.capacity()));
+        if (!loaded)
+            return false;
+        // The heuristics section is optional; a rejected one leaves the loaded TT in place.
+        if (in.peek() != std::char_traits<char>::eof() && !context_.read_heuristics(in, error))
+            error = "histories not loaded: " + error;
+        return true;
+    }
+
     bool Engine::search_position(chess::Board &board,
                                  int depth,
                                  SearchResult &result,
@@ -531,12 +757,60 @@ namespace fast_engine
                                       bool keep_searching_at_max_depth)
     {
         tt_.new_search();
+        // Lazy SMP: helpers share the TT and search until the main thread finishes.
+        // Time management, aspiration windows and info output stay on the main thread.
+        const int helper_count = std::clamp(config_.threads, 1, MAX_SEARCH_THREADS) - 1;
+        // NumaPolicy auto: every search thread is pinned to a node before it binds its slot.
+        const int main_node = numa_node_for_thread(config_.numa_policy, 0, helper_count + 1);
+        numa_bind_current_thread(main_node);
+        const ScopedSearchBinding binding(context_, 0, main_node);
+        profile_reset_thread_counters();
         const bool use_quiescence = config_.use_quiescence;
 
+        // Resume from the previous search when this root is where it ended (ponderhit) or
+        // the reply it predicted. A reply carryover needs its PV move still in the TT.
+        // Shallow probes (the UCI ponder-move guess) neither use nor drop the carryover.
+        RootCarryover carry{};
+        const bool carryover_search = config_.search_carryover && max_depth >= CARRYOVER_MIN_DEPTH;
+        if (carryover_search)
+        {
+            const std::uint64_t key = board.hash();
+            if (carry_root_.valid && carry_root_.key == key)
+            {
+                carry = std::move(carry_root_);
+            }
+            else if (carry_reply_.valid && carry_reply_.key == key)
+            {
+                carry = std::move(carry_reply_);
+                const auto entry = tt_.probe(key);
+                if (entry && entry->hasMove && entry->bestMove == carry.best_move && is_legal_move(board, carry.best_move))
+                    carry.depth = std::min(carry.depth, entry->depth);
+                else
+                    carry.valid = false;
+            }
+            carry.valid = carry.valid && carry.depth >= CARRYOVER_MIN_DEPTH;
+            drop_carryover();
+        }
+        const int resume_depth = carry.valid ? std::min(carry.depth, max_depth - 1) : 0;
+
+        std::atomic<bool> helpers_stop{false};
+        std::atomic<std::uint64_t> helper_nodes{0};
+        std::vector<HelperSearchOutcome> helper_outcomes(static_cast<std::size_t>(helper_count));
+        helpers_.reserve(helper_count);
+        for (int i = 0; i < helper_count; ++i)
+        {
+            HelperSearchOutcome &outcome = helper_outcomes[static_cast<std::size_t>(i)];
+            const int node = numa_node_for_thread(config_.numa_policy, i + 1, helper_count + 1);
+            helpers_.start(i, [this, i, node, board, resume_depth, max_depth, &helpers_stop, &helper_nodes, &outcome]()
+                           { run_helper_search(context_, i + 1, node, board, resume_depth + 1, max_depth, config_, tt_,
+                                               helpers_stop, helper_nodes, outcome); });
+        }
+
         // Best info from the *deepest* completed iteration
         chess::Move best_move{};
         Score best_score = 0;
         bool has_best = false;
+        int best_depth = 0;
 
         // Aggregated stats over all iterations
         SearchStats total_stats{};
@@ -616,6 +890,27 @@ namespace fast_engine
         bool have_prev = false;
         Score prev_score = 0;
         std::vector<RootMove> root_moves;
+        Score carried_window = 0;
+
+        int cur_depth = 1;
+        if (resume_depth > 0)
+        {
+            // The carried iteration counts as completed: a stop before the first resumed
+            // iteration finishes still returns its move.
+            best_move = carry.best_move;
+            best_score = carry.score;
+            has_best = true;
+            best_depth = resume_depth;
+            total_stats.depth_reached = resume_depth;
+            have_prev = true;
+            prev_score = carry.score;
+            carried_window = carry.window;
+            root_moves = std::move(carry.root_moves);
+            prev_best_move_all = carry.best_move;
+            last_pv0_change_depth = root_moves.empty() ? resume_depth : carry.pv_change_depth;
+            previous_time_reduction = carry.time_reduction;
+            cur_depth = resume_depth + 1;
+        }
 
         // Diagnostics: track how often the root PV first move changes late (depth >= 10).
         chess::Move prev_best_move_ge10 = chess::Move(chess::Move::NO_MOVE);
@@ -624,7 +919,6 @@ namespace fast_engine
         constexpr Score INF = SCORE_INF;
         constexpr Score MATE_BOUND = ::fast_engine::MATE_BOUND;
 
-        int cur_depth = 1;
         for (;;)
         {
             if (!keep_searching_at_max_depth && cur_depth > max_depth)
@@ -662,8 +956,10 @@ namespace fast_engine
             Score beta = INF;
 
             const bool use_aspiration = have_prev && score_abs(prev_score) < MATE_BOUND;
-            Score lower_window = initial_root_aspiration_window(depth_to_search, final_root_telemetry);
+            Score lower_window = carried_window > 0 ? carried_window
+                                                    : initial_root_aspiration_window(depth_to_search, final_root_telemetry);
             Score upper_window = lower_window;
+            carried_window = 0;
             if (use_aspiration)
             {
                 alpha = prev_score - lower_window;
@@ -705,31 +1001,7 @@ namespace fast_engine
                 }
 
                 // Aggregate stats for every attempt (including re-searches)
-                total_stats.nodes += iter_stats.nodes;
-                total_stats.tt_hits += iter_stats.tt_hits;
-                total_stats.tt_misses += iter_stats.tt_misses;
-                total_stats.quiet_searched_ge10 += iter_stats.quiet_searched_ge10;
-                total_stats.quiet_researched_ge10 += iter_stats.quiet_researched_ge10;
-                total_stats.badcap_nodes += iter_stats.badcap_nodes;
-                total_stats.badcap_picked += iter_stats.badcap_picked;
-                total_stats.badcap_searched += iter_stats.badcap_searched;
-                total_stats.badcap_gen_nodes += iter_stats.badcap_gen_nodes;
-                total_stats.badcap_generated += iter_stats.badcap_generated;
-
-                total_stats.razor_attempts += iter_stats.razor_attempts;
-                total_stats.razor_cutoffs += iter_stats.razor_cutoffs;
-                total_stats.probcut_nodes += iter_stats.probcut_nodes;
-                total_stats.probcut_candidates += iter_stats.probcut_candidates;
-                total_stats.probcut_see_rejects += iter_stats.probcut_see_rejects;
-                total_stats.probcut_qs_passes += iter_stats.probcut_qs_passes;
-                total_stats.probcut_searches += iter_stats.probcut_searches;
-                total_stats.probcut_cutoffs += iter_stats.probcut_cutoffs;
-                total_stats.legal_movegen_calls += iter_stats.legal_movegen_calls;
-                total_stats.legal_moves_generated += iter_stats.legal_moves_generated;
-                total_stats.neural_accumulator.refreshes += iter_stats.neural_accumulator.refreshes;
-                total_stats.neural_accumulator.invalid_fallbacks += iter_stats.neural_accumulator.invalid_fallbacks;
-                total_stats.neural_accumulator.delta_updates += iter_stats.neural_accumulator.delta_updates;
-                total_stats.neural_accumulator.check_failures += iter_stats.neural_accumulator.check_failures;
+                accumulate_search_counters(total_stats, iter_stats);
 
                 total_stats.is_mate = iter_stats.is_mate;
                 total_stats.is_draw = iter_stats.is_draw;
@@ -807,30 +1079,7 @@ namespace fast_engine
                     ok = false;
                 }
 
-                total_stats.nodes += iter_stats.nodes;
-                total_stats.tt_hits += iter_stats.tt_hits;
-                total_stats.tt_misses += iter_stats.tt_misses;
-                total_stats.quiet_searched_ge10 += iter_stats.quiet_searched_ge10;
-                total_stats.quiet_researched_ge10 += iter_stats.quiet_researched_ge10;
-                total_stats.badcap_nodes += iter_stats.badcap_nodes;
-                total_stats.badcap_picked += iter_stats.badcap_picked;
-                total_stats.badcap_searched += iter_stats.badcap_searched;
-                total_stats.badcap_gen_nodes += iter_stats.badcap_gen_nodes;
-                total_stats.badcap_generated += iter_stats.badcap_generated;
-                total_stats.razor_attempts += iter_stats.razor_attempts;
-                total_stats.razor_cutoffs += iter_stats.razor_cutoffs;
-                total_stats.probcut_nodes += iter_stats.probcut_nodes;
-                total_stats.probcut_candidates += iter_stats.probcut_candidates;
-                total_stats.probcut_see_rejects += iter_stats.probcut_see_rejects;
-                total_stats.probcut_qs_passes += iter_stats.probcut_qs_passes;
-                total_stats.probcut_searches += iter_stats.probcut_searches;
-                total_stats.probcut_cutoffs += iter_stats.probcut_cutoffs;
-                total_stats.legal_movegen_calls += iter_stats.legal_movegen_calls;
-                total_stats.legal_moves_generated += iter_stats.legal_moves_generated;
-                total_stats.neural_accumulator.refreshes += iter_stats.neural_accumulator.refreshes;
-                total_stats.neural_accumulator.invalid_fallbacks += iter_stats.neural_accumulator.invalid_fallbacks;
-                total_stats.neural_accumulator.delta_updates += iter_stats.neural_accumulator.delta_updates;
-                total_stats.neural_accumulator.check_failures += iter_stats.neural_accumulator.check_failures;
+                accumulate_search_counters(total_stats, iter_stats);
                 total_stats.is_mate = iter_stats.is_mate;
                 total_stats.is_draw = iter_stats.is_draw;
                 total_stats.depth_reached = std::max(total_stats.depth_reached, iter_stats.depth_reached);
@@ -887,6 +1136,7 @@ namespace fast_engine
             has_best = last_stats.has_best_move;
             best_move = iter_best_move;
             best_score = iter_best_score;
+            best_depth = depth_to_search;
             final_root_telemetry = iter_root_telemetry;
             total_aspiration_retries += iter_root_telemetry.aspiration_retries;
             total_aspiration_fail_lows += iter_root_telemetry.aspiration_fail_lows;
@@ -901,18 +1151,20 @@ namespace fast_engine
             {
                 const auto now = std::chrono::steady_clock::now();
                 const double elapsed = std::chrono::duration<double>(now - start).count();
-                const double nps = (elapsed > 0.0) ? (static_cast<double>(total_stats.nodes) / elapsed) : 0.0;
+                const std::uint64_t all_nodes = total_stats.nodes + helper_nodes.load(std::memory_order_relaxed);
+                const double nps = (elapsed > 0.0) ? (static_cast<double>(all_nodes) / elapsed) : 0.0;
 
                 IterationInfo ii{};
                 ii.depth = depth_to_search;
                 ii.score = iter_best_score;
                 ii.best_move = iter_best_move;
                 ii.has_best_move = last_stats.has_best_move;
-                ii.nodes = total_stats.nodes;
+                ii.nodes = all_nodes;
                 ii.time_seconds = elapsed;
                 ii.nps = nps;
                 ii.tt_hits = total_stats.tt_hits;
                 ii.tt_misses = total_stats.tt_misses;
+                ii.tb_hits = total_stats.tb_hits;
                 ii.is_mate = total_stats.is_mate;
                 ii.is_draw = total_stats.is_draw;
                 ii.aspiration_retries = iter_root_telemetry.aspiration_retries;
@@ -966,6 +1218,58 @@ namespace fast_engine
             // else: stay at max_depth and keep searching until externally stopped.
         }
 
+        // Carry this root over to the next search (ponderhit restarts on it). A stop before
+        // the first resumed iteration finished passes the incoming carryover on unchanged.
+        if (carryover_search && has_best && best_depth >= CARRYOVER_MIN_DEPTH)
+        {
+            carry_root_.valid = true;
+            carry_root_.key = board.hash();
+            carry_root_.depth = best_depth;
+            carry_root_.score = best_score;
+            carry_root_.window = (best_depth == resume_depth)
+                                     ? carry.window
+                                     : initial_root_aspiration_window(best_depth + 1, final_root_telemetry);
+            carry_root_.best_move = best_move;
+            carry_root_.pv_change_depth = last_pv0_change_depth;
+            carry_root_.time_reduction = previous_time_reduction;
+            carry_root_.root_moves = std::move(root_moves);
+        }
+
+        helpers_stop.store(true, std::memory_order_relaxed);
+        helpers_.wait_all();
+
+        // Combine helper work: all nodes count, and a helper that completed a deeper
+        // iteration than the main thread supplies the final move and score.
+        for (const HelperSearchOutcome &helper : helper_outcomes)
+        {
+            accumulate_search_counters(total_stats, helper.stats);
+            if (helper.has_best && helper.depth > best_depth)
+            {
+                best_move = helper.best_move;
+                best_score = helper.score;
+                best_depth = helper.depth;
+                has_best = true;
+            }
+        }
+        total_stats.depth_reached = std::max(total_stats.depth_reached, best_depth);
+
+        // The position two plies down the PV was searched about two plies shallower; if the
+        // opponent plays the predicted reply, the next search resumes there.
+        if (carryover_search && has_best && best_depth - 2 >= CARRYOVER_MIN_DEPTH)
+        {
+            chess::Board line = board;
+            const chess::Move next = predicted_line_move(line, tt_, best_move);
+            if (next != chess::Move::NO_MOVE)
+            {
+                carry_reply_.valid = true;
+                carry_reply_.key = line.hash();
+                carry_reply_.depth = best_depth - 2;
+                carry_reply_.score = best_score;
+                carry_reply_.window = initial_root_aspiration_window(best_depth - 1, final_root_telemetry);
+                carry_reply_.best_move = next;
+            }
+        }
+
         const auto end = std::chrono::steady_clock::now();
         const double elapsed = std::chrono::duration<double>(end - start).count();
         const double nps = (elapsed > 0.0 ? total_stats.nodes / elapsed : 0.0);
@@ -975,6 +1279,13 @@ namespace fast_engine
         result.best_move = best_move;
         result.has_best_move = has_best;
 
+        result.pv_uci = has_best ? build_pv_uci(board, tt_, best_move, /*max_len=*/16) : std::string();
+
+        // Search is over: if the TT generation is close to wrapping, wipe it now in the
+        // background so the next go does not pay for the full-table clear.
+        tt_.schedule_wrap_clear();
+        result.threads = helper_count + 1;
+
         result.nodes = total_stats.nodes;
         result.depth_reached = total_stats.depth_reached;
         result.depth_requested = total_stats.depth_requested;
@@ -983,6 +1294,7 @@ namespace fast_engine
 
         result.tt_hits = total_stats.tt_hits;
         result.tt_misses = total_stats.tt_misses;
+        result.tb_hits = total_stats.tb_hits;
         const auto total_tt_q = total_stats.tt_hits + total_stats.tt_misses;
         result.tt_hit_rate = (total_tt_q > 0)
                                  ? (100.0 * static_cast<double>(total_stats.tt_hits) /
@@ -1015,6 +1327,13 @@ namespace fast_engine
         result.legal_movegen_calls = total_stats.legal_movegen_calls;
         result.legal_moves_generated = total_stats.legal_moves_generated;
         result.neural_accumulator = total_stats.neural_accumulator;
+        result.profile = profile_thread_counters();
+        result.eval_cache = eval_cache_thread_stats();
+        for (const HelperSearchOutcome &helper : helper_outcomes)
+        {
+            result.profile.add(helper.profile);
+            result.eval_cache.add(helper.eval_cache);
+        }
         result.aspiration_retries_total = total_aspiration_retries;
         result.aspiration_fail_lows_total = total_aspiration_fail_lows;
         result.aspiration_fail_highs_total = total_aspiration_fail_highs;
@@ -1,25 +1,41 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
 #include <cmath>
 #include <cstring>
 #include <cstdint>
 #include <cstddef>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <new>
+#include <random>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
 #if defined(__AVX512F__) || defined(SHAKEYBOT_ENABLE_AVX512_DISPATCH) || \
     defined(__AVX2__) || defined(SHAKEYBOT_ENABLE_AVX2_DISPATCH)
 #include <immintrin.h>
 #elif defined(__SSE2__)
 #include <emmintrin.h>
 #endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 #include "fast_engine/evaluation.hpp"
 #include "fast_engine/config.hpp"
+#include "fast_engine/embedded_net.hpp"
+#include "fast_engine/large_pages.hpp"
+#include "fast_engine/mapped_file.hpp"
+#include "fast_engine/profile.hpp"
 
 // Evaluation uses one compilation unit with small internal modules.
 // The include order below is part of the eval pipeline.
@@ -91,6 +107,42 @@ namespace fast_engine
         template <typename T>
         using AlignedVector = std::vector<T, AlignedAllocator<T, NEURAL_CACHELINE_ALIGNMENT>>;
 
+        // Weight block that either owns an aligned buffer (text models) or views a
+        // read-only mapped binary model in place. Only owned blocks are writable.
+        template <typename T>
+        class NeuralWeightBlock
+        {
+        public:
+            void resize(std::size_t count)
+            {
+                owned_.assign(count, T{});
+                view_ = nullptr;
+                size_ = count;
+            }
+
+            void bind(const T *view, std::size_t count) noexcept
+            {
+                owned_.clear();
+                owned_.shrink_to_fit();
+                view_ = view;
+                size_ = count;
+            }
+
+            const T *data() const noexcept { return view_ ? view_ : owned_.data(); }
+            T *begin() noexcept { return owned_.data(); }
+            T *end() noexcept { return owned_.data() + owned_.size(); }
+            const T *begin() const noexcept { return data(); }
+            const T *end() const noexcept { return data() + size_; }
+            const T &operator[](std::size_t i) const noexcept { return data()[i]; }
+            std::size_t size() const noexcept { return size_; }
+            bool mapped() const noexcept { return view_ != nullptr; }
+
+        private:
+            AlignedVector<T> owned_;
+            const T *view_ = nullptr;
+            std::size_t size_ = 0;
+        };
+
 #if defined(__AVX2__)
 #define SHAKEYBOT_HAS_AVX2_KERNELS 1
 #define SHAKEYBOT_AVX2_TARGET
@@ -117,6 +169,41 @@ namespace fast_engine
 #define SHAKEYBOT_AVX512_TARGET
 #endif
 
+// VNNI (vpdpwssd) fuses the int16 multiply-add into int32 lanes: AVX512-VNNI on Ice Lake /
+// Zen 4, AVX-VNNI (256-bit, VEX) on Alder Lake and later.
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VNNI__)
+#define SHAKEYBOT_HAS_AVX512_VNNI_KERNELS 1
+#define SHAKEYBOT_AVX512_VNNI_TARGET
+#elif defined(SHAKEYBOT_ENABLE_VNNI_DISPATCH) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHAKEYBOT_HAS_AVX512_VNNI_KERNELS 1
+#define SHAKEYBOT_AVX512_VNNI_TARGET __attribute__((target("avx512f,avx512bw,avx512vnni")))
+#else
+#define SHAKEYBOT_HAS_AVX512_VNNI_KERNELS 0
+#define SHAKEYBOT_AVX512_VNNI_TARGET
+#endif
+
+#if defined(__AVX2__) && defined(__AVXVNNI__)
+#define SHAKEYBOT_HAS_AVXVNNI_KERNELS 1
+#define SHAKEYBOT_AVXVNNI_TARGET
+#elif defined(SHAKEYBOT_ENABLE_VNNI_DISPATCH) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHAKEYBOT_HAS_AVXVNNI_KERNELS 1
+#define SHAKEYBOT_AVXVNNI_TARGET __attribute__((target("avx2,avxvnni")))
+#else
+#define SHAKEYBOT_HAS_AVXVNNI_KERNELS 0
+#define SHAKEYBOT_AVXVNNI_TARGET
+#endif
+
+// Advanced SIMD is mandatory on AArch64, so NEON kernels need no runtime check.
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define SHAKEYBOT_HAS_NEON_KERNELS 1
+#else
+#define SHAKEYBOT_HAS_NEON_KERNELS 0
+#endif
+
 #if SHAKEYBOT_HAS_AVX2_KERNELS
 #if !defined(__AVX2__)
         static const bool NEURAL_CPU_SUPPORTS_AVX2 = []() noexcept {
@@ -165,6 +252,147 @@ namespace fast_engine
         }
 #endif
 
+#if SHAKEYBOT_HAS_AVX512_VNNI_KERNELS
+#if !(defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VNNI__))
+        static const bool NEURAL_CPU_SUPPORTS_AVX512_VNNI = []() noexcept {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f") != 0 &&
+                   __builtin_cpu_supports("avx512bw") != 0 &&
+                   __builtin_cpu_supports("avx512vnni") != 0;
+        }();
+#endif
+
+        static inline bool neural_cpu_supports_avx512_vnni() noexcept
+        {
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VNNI__)
+            return true;
+#else
+            return NEURAL_CPU_SUPPORTS_AVX512_VNNI;
+#endif
+        }
+#else
+        static inline bool neural_cpu_supports_avx512_vnni() noexcept
+        {
+            return false;
+        }
+#endif
+
+#if SHAKEYBOT_HAS_AVXVNNI_KERNELS
+#if !(defined(__AVX2__) && defined(__AVXVNNI__))
+        static const bool NEURAL_CPU_SUPPORTS_AVXVNNI = []() noexcept {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0 &&
+                   __builtin_cpu_supports("avxvnni") != 0;
+        }();
+#endif
+
+        static inline bool neural_cpu_supports_avxvnni() noexcept
+        {
+#if defined(__AVX2__) && defined(__AVXVNNI__)
+            return true;
+#else
+            return NEURAL_CPU_SUPPORTS_AVXVNNI;
+#endif
+        }
+#else
+        static inline bool neural_cpu_supports_avxvnni() noexcept
+        {
+            return false;
+        }
+#endif
+
+        // The VNNI dot kernels narrow clamped activations to int16, so they need
+        // max_value <= INT16_MAX. Each vpdpwssd lane then adds two products of magnitude
+        // at most max_value * 32768; this many steps fit an int32 lane before it has to
+        // be widened into the int64 total.
+        static inline int neural_vnni_steps_before_widen(std::int32_t max_value) noexcept
+        {
+            const std::int64_t per_step = 2 * static_cast<std::int64_t>(max_value) * 32768;
+            return static_cast<int>(std::max<std::int64_t>(1, std::numeric_limits<std::int32_t>::max() / per_step));
+        }
+
+#if SHAKEYBOT_HAS_AVX512_VNNI_KERNELS
+        SHAKEYBOT_AVX512_VNNI_TARGET static inline std::int64_t neural_dot_clamped_i32_i16_avx512_vnni(
+            const std::int32_t *input,
+            const std::int16_t *weights,
+            int count,
+            std::int32_t max_value) noexcept
+        {
+            const __m512i zero = _mm512_setzero_si512();
+            const __m512i max_activation = _mm512_set1_epi32(max_value);
+            const int steps = neural_vnni_steps_before_widen(max_value);
+            std::int64_t total = 0;
+            int i = 0;
+            while (i + 32 <= count)
+            {
+                __m512i sum = _mm512_setzero_si512();
+                for (int step = 0; step < steps && i + 32 <= count; ++step, i += 32)
+                {
+                    __m512i lo = _mm512_loadu_si512(reinterpret_cast<const void *>(input + i));
+                    __m512i hi = _mm512_loadu_si512(reinterpret_cast<const void *>(input + i + 16));
+                    lo = _mm512_min_epi32(_mm512_max_epi32(lo, zero), max_activation);
+                    hi = _mm512_min_epi32(_mm512_max_epi32(hi, zero), max_activation);
+                    const __m512i activations = _mm512_inserti64x4(
+                        _mm512_castsi256_si512(_mm512_cvtepi32_epi16(lo)), _mm512_cvtepi32_epi16(hi), 1);
+                    const __m512i packed_weights = _mm512_loadu_si512(reinterpret_cast<const void *>(weights + i));
+                    sum = _mm512_dpwssd_epi32(sum, activations, packed_weights);
+                }
+                const __m512i sum_lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(sum));
+                const __m512i sum_hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(sum, 1));
+                total += _mm512_reduce_add_epi64(_mm512_add_epi64(sum_lo, sum_hi));
+            }
+
+            for (; i < count; ++i)
+            {
+                const std::int32_t activation = std::clamp(input[i], 0, max_value);
+                total += static_cast<std::int64_t>(activation) * static_cast<std::int64_t>(weights[i]);
+            }
+            return total;
+        }
+#endif
+
+#if SHAKEYBOT_HAS_AVXVNNI_KERNELS
+        SHAKEYBOT_AVXVNNI_TARGET static inline std::int64_t neural_dot_clamped_i32_i16_avxvnni(
+            const std::int32_t *input,
+            const std::int16_t *weights,
+            int count,
+            std::int32_t max_value) noexcept
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i max_activation = _mm256_set1_epi32(max_value);
+            const int steps = neural_vnni_steps_before_widen(max_value);
+            std::int64_t total = 0;
+            int i = 0;
+            while (i + 16 <= count)
+            {
+                __m256i sum = _mm256_setzero_si256();
+                for (int step = 0; step < steps && i + 16 <= count; ++step, i += 16)
+                {
+                    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+                    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i + 8));
+                    lo = _mm256_min_epi32(_mm256_max_epi32(lo, zero), max_activation);
+                    hi = _mm256_min_epi32(_mm256_max_epi32(hi, zero), max_activation);
+                    // packs works per 128-bit lane; the permute restores element order.
+                    const __m256i activations = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+                    const __m256i packed_weights = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i));
+                    sum = _mm256_dpwssd_avx_epi32(sum, activations, packed_weights);
+                }
+                const __m256i wide = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(sum)),
+                                                      _mm256_cvtepi32_epi64(_mm256_extracti128_si256(sum, 1)));
+                alignas(32) std::int64_t lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), wide);
+                total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            }
+
+            for (; i < count; ++i)
+            {
+                const std::int32_t activation = std::clamp(input[i], 0, max_value);
+                total += static_cast<std::int64_t>(activation) * static_cast<std::int64_t>(weights[i]);
+            }
+            return total;
+        }
+#endif
+
 #if SHAKEYBOT_HAS_AVX512_KERNELS
         SHAKEYBOT_AVX512_TARGET static inline std::int64_t neural_dot_relu_i32_i16_avx512(
             const std::int32_t *input,
@@ -463,6 +691,142 @@ namespace fast_engine
         }
 #endif
 
+#if SHAKEYBOT_HAS_NEON_KERNELS
+        static inline std::int64_t neural_dot_relu_i32_i16_neon(const std::int32_t *input,
+                                                                const std::int16_t *weights,
+                                                                int count) noexcept
+        {
+            const int32x4_t zero = vdupq_n_s32(0);
+            int64x2_t sum_a = vdupq_n_s64(0);
+            int64x2_t sum_b = vdupq_n_s64(0);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const int32x4_t lo = vmaxq_s32(vld1q_s32(input + i), zero);
+                const int32x4_t hi = vmaxq_s32(vld1q_s32(input + i + 4), zero);
+                const int16x8_t packed_weights = vld1q_s16(weights + i);
+                const int32x4_t weights_lo = vmovl_s16(vget_low_s16(packed_weights));
+                const int32x4_t weights_hi = vmovl_high_s16(packed_weights);
+                sum_a = vmlal_s32(sum_a, vget_low_s32(lo), vget_low_s32(weights_lo));
+                sum_b = vmlal_high_s32(sum_b, lo, weights_lo);
+                sum_a = vmlal_s32(sum_a, vget_low_s32(hi), vget_low_s32(weights_hi));
+                sum_b = vmlal_high_s32(sum_b, hi, weights_hi);
+            }
+
+            std::int64_t total = vaddvq_s64(vaddq_s64(sum_a, sum_b));
+            for (; i < count; ++i)
+            {
+                const std::int32_t activation = std::max(input[i], 0);
+                total += static_cast<std::int64_t>(activation) * static_cast<std::int64_t>(weights[i]);
+            }
+            return total;
+        }
+
+        static inline std::int64_t neural_dot_clamped_i32_i16_neon(const std::int32_t *input,
+                                                                   const std::int16_t *weights,
+                                                                   int count,
+                                                                   std::int32_t max_value) noexcept
+        {
+            const int32x4_t zero = vdupq_n_s32(0);
+            const int32x4_t max_activation = vdupq_n_s32(max_value);
+            int64x2_t sum_a = vdupq_n_s64(0);
+            int64x2_t sum_b = vdupq_n_s64(0);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const int32x4_t lo = vminq_s32(vmaxq_s32(vld1q_s32(input + i), zero), max_activation);
+                const int32x4_t hi = vminq_s32(vmaxq_s32(vld1q_s32(input + i + 4), zero), max_activation);
+                const int16x8_t packed_weights = vld1q_s16(weights + i);
+                const int32x4_t weights_lo = vmovl_s16(vget_low_s16(packed_weights));
+                const int32x4_t weights_hi = vmovl_high_s16(packed_weights);
+                sum_a = vmlal_s32(sum_a, vget_low_s32(lo), vget_low_s32(weights_lo));
+                sum_b = vmlal_high_s32(sum_b, lo, weights_lo);
+                sum_a = vmlal_s32(sum_a, vget_low_s32(hi), vget_low_s32(weights_hi));
+                sum_b = vmlal_high_s32(sum_b, hi, weights_hi);
+            }
+
+            std::int64_t total = vaddvq_s64(vaddq_s64(sum_a, sum_b));
+            for (; i < count; ++i)
+            {
+                const std::int32_t activation = std::clamp(input[i], 0, max_value);
+                total += static_cast<std::int64_t>(activation) * static_cast<std::int64_t>(weights[i]);
+            }
+            return total;
+        }
+
+        static inline void neural_accumulate_dual_i32_i16_to_i64_neon(
+            std::int64_t *dst,
+            const std::int16_t *row_a,
+            std::int32_t activation_a,
+            const std::int16_t *row_b,
+            std::int32_t activation_b,
+            int count) noexcept
+        {
+            const int32x4_t a = vdupq_n_s32(activation_a);
+            const int32x4_t b = vdupq_n_s32(activation_b);
+            int i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const int32x4_t weights_a = vmovl_s16(vld1_s16(row_a + i));
+                const int32x4_t weights_b = vmovl_s16(vld1_s16(row_b + i));
+                int64x2_t dst_lo = vld1q_s64(dst + i);
+                int64x2_t dst_hi = vld1q_s64(dst + i + 2);
+                dst_lo = vmlal_s32(dst_lo, vget_low_s32(weights_a), vget_low_s32(a));
+                dst_hi = vmlal_high_s32(dst_hi, weights_a, a);
+                dst_lo = vmlal_s32(dst_lo, vget_low_s32(weights_b), vget_low_s32(b));
+                dst_hi = vmlal_high_s32(dst_hi, weights_b, b);
+                vst1q_s64(dst + i, dst_lo);
+                vst1q_s64(dst + i + 2, dst_hi);
+            }
+
+            for (; i < count; ++i)
+            {
+                dst[i] += static_cast<std::int64_t>(activation_a) * static_cast<std::int64_t>(row_a[i]);
+                dst[i] += static_cast<std::int64_t>(activation_b) * static_cast<std::int64_t>(row_b[i]);
+            }
+        }
+
+        static inline void neural_accumulate_i32_i16_to_i64_evenodd_neon(
+            std::int64_t *dst_even,
+            std::int64_t *dst_odd,
+            const std::int16_t *row,
+            std::int32_t activation,
+            int count) noexcept
+        {
+            const int32x4_t a = vdupq_n_s32(activation);
+            int i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                // vld2 splits the row into its even and odd elements.
+                const int16x4x2_t packed = vld2_s16(row + i);
+                const int32x4_t weights_even = vmovl_s16(packed.val[0]);
+                const int32x4_t weights_odd = vmovl_s16(packed.val[1]);
+                int64x2_t even_lo = vld1q_s64(dst_even + i / 2);
+                int64x2_t even_hi = vld1q_s64(dst_even + i / 2 + 2);
+                int64x2_t odd_lo = vld1q_s64(dst_odd + i / 2);
+                int64x2_t odd_hi = vld1q_s64(dst_odd + i / 2 + 2);
+                even_lo = vmlal_s32(even_lo, vget_low_s32(weights_even), vget_low_s32(a));
+                even_hi = vmlal_high_s32(even_hi, weights_even, a);
+                odd_lo = vmlal_s32(odd_lo, vget_low_s32(weights_odd), vget_low_s32(a));
+                odd_hi = vmlal_high_s32(odd_hi, weights_odd, a);
+                vst1q_s64(dst_even + i / 2, even_lo);
+                vst1q_s64(dst_even + i / 2 + 2, even_hi);
+                vst1q_s64(dst_odd + i / 2, odd_lo);
+                vst1q_s64(dst_odd + i / 2 + 2, odd_hi);
+            }
+
+            for (; i < count; ++i)
+            {
+                const std::int64_t product =
+                    static_cast<std::int64_t>(activation) * static_cast<std::int64_t>(row[i]);
+                if ((i & 1) == 0)
+                    dst_even[i / 2] += product;
+                else
+                    dst_odd[i / 2] += product;
+            }
+        }
+#endif
+
 #include "eval/00_cache.inc"
 #include "eval/01_material_phase.inc"
 #include "eval/02_material_imbalance_sf12.inc"
@@ -488,6 +852,7 @@ namespace fast_engine
 #include "eval/20_neural_simple.inc"
 #include "eval/21_neural_quant.inc"
 #include "eval/22_neural_halfkp.inc"
+#include "eval/23_neural_halfkp_batch.inc"
 
     } // anonymous namespace
 
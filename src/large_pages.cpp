@@ -0,0 +1,152 @@
+#include "fast_engine/large_pages.hpp"
+
+#include <cstdlib>
+#include <mutex>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace fast_engine
+{
+    namespace
+    {
+        constexpr std::size_t HUGE_PAGE_BYTES = 2ULL * 1024ULL * 1024ULL;
+        constexpr std::size_t SMALL_ALIGNMENT = 64;
+
+        static std::size_t round_up(std::size_t bytes, std::size_t granule) noexcept
+        {
+            return ((bytes + granule - 1) / granule) * granule;
+        }
+
+#ifdef _WIN32
+        // MEM_LARGE_PAGES needs SeLockMemoryPrivilege ("Lock pages in memory") on the account.
+        // Enabling it once per process is enough; failure just means ordinary pages.
+        static bool enable_lock_memory_privilege() noexcept
+        {
+            static std::once_flag once;
+            static bool enabled = false;
+            std::call_once(once, []() noexcept
+                           {
+                HANDLE token = nullptr;
+                if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+                    return;
+                TOKEN_PRIVILEGES tp{};
+                if (LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &tp.Privileges[0].Luid))
+                {
+                    tp.PrivilegeCount = 1;
+                    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+                    if (AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) &&
+                        GetLastError() == ERROR_SUCCESS)
+                        enabled = true;
+                }
+                CloseHandle(token); });
+            return enabled;
+        }
+
+        static std::size_t windows_alloc_bytes(std::size_t bytes, PageMode mode) noexcept
+        {
+            if (mode != PageMode::WindowsLarge)
+                return bytes;
+            const std::size_t large = static_cast<std::size_t>(GetLargePageMinimum());
+            return large > 0 ? round_up(bytes, large) : bytes;
+        }
+#endif
+    } // namespace
+
+    const char *page_mode_name(PageMode mode) noexcept
+    {
+        switch (mode)
+        {
+        case PageMode::TransparentHuge:
+            return "thp";
+        case PageMode::HugeTlb:
+            return "hugetlb";
+        case PageMode::WindowsLarge:
+            return "large";
+        case PageMode::Default:
+        default:
+            return "default";
+        }
+    }
+
+    void *large_page_alloc(std::size_t bytes, PageMode &mode_out)
+    {
+        if (bytes == 0)
+            bytes = 1;
+
+#ifdef _WIN32
+        if (bytes >= HUGE_PAGE_BYTES && GetLargePageMinimum() > 0 && enable_lock_memory_privilege())
+        {
+            const std::size_t rounded = windows_alloc_bytes(bytes, PageMode::WindowsLarge);
+            void *p = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (p)
+            {
+                mode_out = PageMode::WindowsLarge;
+                return p;
+            }
+        }
+        void *p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (!p)
+            throw std::bad_alloc();
+        mode_out = PageMode::Default;
+        return p;
+#else
+        if (bytes >= HUGE_PAGE_BYTES)
+        {
+            const std::size_t rounded = round_up(bytes, HUGE_PAGE_BYTES);
+#if defined(__linux__) && defined(MAP_HUGETLB)
+            // Explicit huge pages only succeed when the admin reserved a hugetlb pool.
+            void *p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                mode_out = PageMode::HugeTlb;
+                return p;
+            }
+#endif
+            // Huge-page aligned heap memory lets THP back the table with 2MB pages.
+            void *q = std::aligned_alloc(HUGE_PAGE_BYTES, rounded);
+            if (q)
+            {
+                mode_out = PageMode::Default;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+                if (madvise(q, rounded, MADV_HUGEPAGE) == 0)
+                    mode_out = PageMode::TransparentHuge;
+#endif
+                return q;
+            }
+        }
+
+        void *p = std::aligned_alloc(SMALL_ALIGNMENT, round_up(bytes, SMALL_ALIGNMENT));
+        if (!p)
+            throw std::bad_alloc();
+        mode_out = PageMode::Default;
+        return p;
+#endif
+    }
+
+    void large_page_free(void *ptr, std::size_t bytes, PageMode mode) noexcept
+    {
+        if (!ptr)
+            return;
+#ifdef _WIN32
+        (void)bytes;
+        (void)mode;
+        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+        if (mode == PageMode::HugeTlb)
+        {
+            munmap(ptr, round_up(bytes == 0 ? 1 : bytes, HUGE_PAGE_BYTES));
+            return;
+        }
+        std::free(ptr);
+#endif
+    }
+
+} // namespace fast_engine
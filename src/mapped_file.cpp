@@ -0,0 +1,105 @@
+#include "fast_engine/mapped_file.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fast_engine
+{
+
+    bool MappedFile::open(const std::string &path, std::string &error)
+    {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            error = "could not open file for mapping";
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            error = "could not map empty file";
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            error = "CreateFileMapping failed";
+            return false;
+        }
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            error = "MapViewOfFile failed";
+            return false;
+        }
+        file_ = file;
+        mapping_ = mapping;
+        data_ = static_cast<const unsigned char *>(view);
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        return true;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            error = "could not open file for mapping";
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            error = "could not map empty file";
+            return false;
+        }
+        const std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        // MAP_SHARED: every process mapping the same file reads the same page-cache pages.
+        void *view = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        // The mapping keeps its own reference to the file.
+        ::close(fd);
+        if (view == MAP_FAILED)
+        {
+            error = "mmap failed";
+            return false;
+        }
+        data_ = static_cast<const unsigned char *>(view);
+        size_ = bytes;
+        return true;
+#endif
+    }
+
+    void MappedFile::close() noexcept
+    {
+#ifdef _WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle(static_cast<HANDLE>(mapping_));
+        if (file_)
+            CloseHandle(static_cast<HANDLE>(file_));
+        file_ = nullptr;
+        mapping_ = nullptr;
+#else
+        if (data_)
+            munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+} // namespace fast_engine
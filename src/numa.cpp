@@ -0,0 +1,148 @@
+#include "fast_engine/numa.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace fast_engine
+{
+    namespace
+    {
+        // Parses a sysfs CPU/node list such as "0-3,8-11".
+        static std::vector<int> parse_cpu_list(const std::string &text)
+        {
+            std::vector<int> out;
+            std::stringstream in(text);
+            std::string range;
+            while (std::getline(in, range, ','))
+            {
+                if (range.empty() || range == "\n")
+                    continue;
+                const std::size_t dash = range.find('-');
+                try
+                {
+                    const int first = std::stoi(range.substr(0, dash));
+                    const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                    for (int cpu = first; cpu <= last; ++cpu)
+                        out.push_back(cpu);
+                }
+                catch (...)
+                {
+                    return {};
+                }
+            }
+            return out;
+        }
+
+        static std::string read_first_line(const std::string &path)
+        {
+            std::ifstream in(path);
+            std::string line;
+            std::getline(in, line);
+            return line;
+        }
+
+        struct NumaTopology
+        {
+            std::vector<std::vector<int>> node_cpus; // CPUs per node, nodes without CPUs dropped
+#if defined(__linux__)
+            cpu_set_t process_mask{};
+            bool has_process_mask = false;
+#endif
+        };
+
+        static const NumaTopology &numa_topology()
+        {
+            static const NumaTopology topology = []()
+            {
+                NumaTopology t;
+#if defined(__linux__)
+                t.has_process_mask = sched_getaffinity(0, sizeof(t.process_mask), &t.process_mask) == 0;
+                for (const int node : parse_cpu_list(read_first_line("/sys/devices/system/node/online")))
+                {
+                    std::vector<int> cpus = parse_cpu_list(
+                        read_first_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+                    // Keep only CPUs this process may run on (cgroups / taskset).
+                    if (t.has_process_mask)
+                        cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&t](int cpu)
+                                                  { return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &t.process_mask); }),
+                                   cpus.end());
+                    if (!cpus.empty())
+                        t.node_cpus.push_back(std::move(cpus));
+                }
+#endif
+                return t;
+            }();
+            return topology;
+        }
+
+        thread_local int g_bound_node = -1;
+    } // namespace
+
+    const char *numa_policy_name(NumaPolicy policy) noexcept
+    {
+        return policy == NumaPolicy::Auto ? "auto" : "none";
+    }
+
+    bool parse_numa_policy(const std::string &name, NumaPolicy &out) noexcept
+    {
+        if (name == "none")
+            out = NumaPolicy::None;
+        else if (name == "auto")
+            out = NumaPolicy::Auto;
+        else
+            return false;
+        return true;
+    }
+
+    int numa_node_count() noexcept
+    {
+        return std::max<int>(1, static_cast<int>(numa_topology().node_cpus.size()));
+    }
+
+    int numa_node_for_thread(NumaPolicy policy, int thread_index, int thread_count) noexcept
+    {
+        const int nodes = numa_node_count();
+        if (policy == NumaPolicy::None || nodes < 2)
+            return -1;
+        const int count = std::max(1, thread_count);
+        const int index = std::clamp(thread_index, 0, count - 1);
+        return static_cast<int>(static_cast<long long>(index) * nodes / count);
+    }
+
+    bool numa_bind_current_thread(int node) noexcept
+    {
+        if (node == g_bound_node)
+            return true;
+#if defined(__linux__)
+        const NumaTopology &topology = numa_topology();
+        cpu_set_t mask;
+        if (node < 0)
+        {
+            if (!topology.has_process_mask)
+                return false;
+            mask = topology.process_mask;
+        }
+        else
+        {
+            if (node >= static_cast<int>(topology.node_cpus.size()))
+                return false;
+            CPU_ZERO(&mask);
+            for (const int cpu : topology.node_cpus[static_cast<std::size_t>(node)])
+                CPU_SET(cpu, &mask);
+        }
+        if (sched_setaffinity(0, sizeof(mask), &mask) != 0)
+            return false;
+        g_bound_node = node;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+} // namespace fast_engine
@@ -3,14 +3,37 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <istream>
 #include <limits>
+#include <ostream>
+#include <type_traits>
+#include <memory>
 #include <vector>
 #include <mutex>
+#if defined(__AVX2__) || defined(SHAKEYBOT_ENABLE_AVX2_DISPATCH)
+#include <immintrin.h>
+#endif
 #include "fast_engine/search.hpp"
 #include "fast_engine/evaluation.hpp"
+#include "fast_engine/profile.hpp"
 #include "fast_engine/tablebase.hpp"
 #include "fast_engine/transposition.hpp"
 
+// Move-ordering kernels (history gathers, argmax) follow the same dispatch
+// rules as the NNUE kernels in evaluation.cpp.
+#if defined(__AVX2__)
+#define SHAKEYBOT_HAS_SEARCH_AVX2 1
+#define SHAKEYBOT_SEARCH_AVX2_TARGET
+#elif defined(SHAKEYBOT_ENABLE_AVX2_DISPATCH) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHAKEYBOT_HAS_SEARCH_AVX2 1
+#define SHAKEYBOT_SEARCH_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define SHAKEYBOT_HAS_SEARCH_AVX2 0
+#define SHAKEYBOT_SEARCH_AVX2_TARGET
+#endif
+
 namespace fast_engine
 {
     constexpr Score ONE_CP = 1;
@@ -0,0 +1,215 @@
+#include "fast_engine/selfplay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "chess.hpp"
+#include "fast_engine/engine.hpp"
+
+namespace fast_engine
+{
+    namespace
+    {
+        static std::uint64_t splitmix64_next(std::uint64_t &state) noexcept
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        static void put_u8(std::string &out, std::uint8_t v) { out.push_back(static_cast<char>(v)); }
+
+        static void put_u16(std::string &out, std::uint16_t v)
+        {
+            put_u8(out, static_cast<std::uint8_t>(v & 0xFFu));
+            put_u8(out, static_cast<std::uint8_t>(v >> 8));
+        }
+
+        static void put_u32(std::string &out, std::uint32_t v)
+        {
+            put_u16(out, static_cast<std::uint16_t>(v & 0xFFFFu));
+            put_u16(out, static_cast<std::uint16_t>(v >> 16));
+        }
+
+        static std::string encode_game(const SelfplayGame &game)
+        {
+            std::string out;
+            const std::size_t fen_len = std::min<std::size_t>(game.start_fen.size(), 0xFFFFu);
+            const std::size_t plies = std::min<std::size_t>(game.moves.size(), 0xFFFFu);
+            out.reserve(10 + fen_len + plies * 4);
+            put_u32(out, static_cast<std::uint32_t>(game.index));
+            put_u8(out, static_cast<std::uint8_t>(game.result));
+            put_u8(out, game.a_is_white ? 1u : 0u);
+            put_u16(out, static_cast<std::uint16_t>(fen_len));
+            out.append(game.start_fen, 0, fen_len);
+            put_u16(out, static_cast<std::uint16_t>(plies));
+            for (std::size_t i = 0; i < plies; ++i)
+            {
+                put_u16(out, game.moves[i]);
+                put_u16(out, static_cast<std::uint16_t>(game.scores[i]));
+            }
+            return out;
+        }
+
+        // Plays `plies` random legal moves; both games of a colour-swapped pair get the same
+        // opening because the seed depends only on the pair index.
+        static void play_random_opening(chess::Board &board, int plies, std::uint64_t seed)
+        {
+            std::uint64_t state = seed;
+            for (int i = 0; i < plies; ++i)
+            {
+                chess::Movelist moves;
+                chess::movegen::legalmoves(moves, board);
+                if (moves.empty())
+                    return;
+                const std::size_t pick = static_cast<std::size_t>(splitmix64_next(state) % static_cast<std::uint64_t>(moves.size()));
+                board.makeMove(moves[static_cast<int>(pick)]);
+            }
+        }
+
+        struct SelfplayShared
+        {
+            const SelfplayOptions &options;
+            std::atomic<int> next_game{0};
+            std::mutex mutex; // guards summary, log and callback
+            SelfplaySummary &summary;
+            std::ofstream *log = nullptr;
+            const SelfplayGameCallback &on_game;
+        };
+
+        static EngineConfig worker_config(const SelfplayOptions &options, int side)
+        {
+            EngineConfig cfg = options.config[side];
+            cfg.threads = 1;
+            cfg.hash_mb = std::max(1, options.hash_mb);
+            cfg.ponder = false;
+            return cfg;
+        }
+
+        static void play_game(SelfplayShared &shared, Engine (&engines)[2], int index)
+        {
+            const SelfplayOptions &options = shared.options;
+            SelfplayGame game;
+            game.index = index;
+            game.a_is_white = (index % 2) == 0;
+
+            const int pair = index / 2;
+            const std::string opening = options.openings.empty()
+                                            ? std::string(chess::constants::STARTPOS)
+                                            : options.openings[static_cast<std::size_t>(pair) % options.openings.size()];
+            chess::Board board(opening);
+            play_random_opening(board, std::max(0, options.random_plies),
+                                options.seed ^ (static_cast<std::uint64_t>(pair) * 0xD1B54A32D192ED03ULL));
+            game.start_fen = board.getFen();
+
+            for (Engine &engine : engines)
+            {
+                engine.clearTT();
+                engine.resetHeuristics();
+                engine.clearEvalCache();
+            }
+
+            SearchLimits limits{};
+            limits.movetime_ms = options.movetime_ms;
+            const int max_plies = std::max(1, options.max_plies);
+            game.result = SelfplayResult::Draw;
+            for (int ply = 0; ply < max_plies; ++ply)
+            {
+                const auto [reason, outcome] = board.isGameOver();
+                if (reason != chess::GameResultReason::NONE)
+                {
+                    if (outcome == chess::GameResult::LOSE)
+                        game.result = (board.sideToMove() == chess::Color::WHITE) ? SelfplayResult::BlackWin : SelfplayResult::WhiteWin;
+                    break;
+                }
+
+                const bool white_to_move = board.sideToMove() == chess::Color::WHITE;
+                Engine &engine = engines[(white_to_move == game.a_is_white) ? 0 : 1];
+                SearchResult result{};
+                if (options.movetime_ms > 0)
+                    engine.search_position(board, limits, result);
+                else
+                    engine.search_position(board, std::max(1, options.depth), result);
+                if (!result.has_best_move)
+                    break;
+
+                const int white_score = white_to_move ? result.score : -result.score;
+                game.moves.push_back(result.best_move.move());
+                game.scores.push_back(static_cast<std::int16_t>(std::clamp(white_score, -32767, 32767)));
+                game.nodes += result.nodes;
+                board.makeMove(result.best_move);
+            }
+
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            SelfplaySummary &summary = shared.summary;
+            ++summary.games;
+            summary.plies += game.moves.size();
+            summary.nodes += game.nodes;
+            if (game.result == SelfplayResult::Draw)
+                ++summary.draws;
+            else if ((game.result == SelfplayResult::WhiteWin) == game.a_is_white)
+                ++summary.a_wins;
+            else
+                ++summary.b_wins;
+            if (shared.log)
+            {
+                const std::string record = encode_game(game);
+                shared.log->write(record.data(), static_cast<std::streamsize>(record.size()));
+            }
+            if (shared.on_game)
+                shared.on_game(game);
+        }
+
+        static void selfplay_worker(SelfplayShared &shared)
+        {
+            Engine engines[2] = {Engine(worker_config(shared.options, 0)),
+                                 Engine(worker_config(shared.options, 1))};
+            for (;;)
+            {
+                const int index = shared.next_game.fetch_add(1, std::memory_order_relaxed);
+                if (index >= shared.options.games)
+                    break;
+                play_game(shared, engines, index);
+            }
+        }
+    } // namespace
+
+    bool run_selfplay(const SelfplayOptions &options,
+                      SelfplaySummary &summary,
+                      std::string &error,
+                      const SelfplayGameCallback &on_game)
+    {
+        summary = SelfplaySummary{};
+        std::ofstream log;
+        if (!options.log_path.empty())
+        {
+            log.open(options.log_path, std::ios::binary | std::ios::trunc);
+            if (!log)
+            {
+                error = "cannot open selfplay log: " + options.log_path;
+                return false;
+            }
+            log.write(SELFPLAY_LOG_MAGIC, sizeof(SELFPLAY_LOG_MAGIC));
+        }
+
+        SelfplayShared shared{options, {}, {}, summary, log.is_open() ? &log : nullptr, on_game};
+        const auto start = std::chrono::steady_clock::now();
+        const int workers = std::clamp(options.threads, 1, std::max(1, options.games));
+        std::vector<std::thread> pool;
+        pool.reserve(static_cast<std::size_t>(workers - 1));
+        for (int w = 1; w < workers; ++w)
+            pool.emplace_back(selfplay_worker, std::ref(shared));
+        selfplay_worker(shared);
+        for (std::thread &t : pool)
+            t.join();
+        summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+} // namespace fast_engine
@@ -1,6 +1,8 @@
 #include "fast_engine/tablebase.hpp"
 
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <string>
 
@@ -14,6 +16,26 @@ namespace fast_engine
         std::mutex g_tb_mutex;
         std::string g_tb_path;
         bool g_tb_ready = false;
+        // Read by in-search probes without the mutex. The generation changes whenever the
+        // tables are reloaded, which invalidates every thread's WDL cache.
+        std::atomic<int> g_tb_max_pieces{0};
+        std::atomic<std::uint32_t> g_tb_generation{1};
+
+        struct WdlCacheEntry
+        {
+            std::uint64_t key = 0;
+            std::uint32_t generation = 0;
+            std::int32_t wdl = 0;
+        };
+
+        constexpr std::size_t WDL_CACHE_ENTRIES = 4096; // per thread, direct-mapped
+        thread_local std::array<WdlCacheEntry, WDL_CACHE_ENTRIES> t_wdl_cache{};
+
+        static void publish_tb_state_locked() noexcept
+        {
+            g_tb_max_pieces.store(g_tb_ready ? static_cast<int>(TB_LARGEST) : 0, std::memory_order_release);
+            g_tb_generation.fetch_add(1, std::memory_order_acq_rel);
+        }
 
         static int piece_count(const chess::Board &board) noexcept
         {
@@ -22,22 +44,17 @@ namespace fast_engine
 
         static bool ensure_tb_ready_locked(const std::string &path)
         {
-            if (path.empty())
-            {
-                if (g_tb_ready || !g_tb_path.empty())
-                    tb_free();
-                g_tb_path.clear();
-                g_tb_ready = false;
-                return false;
-            }
-
-            const std::filesystem::path resolved = resolve_named_directory_upward(path);
+            const std::filesystem::path resolved = path.empty() ? std::filesystem::path() : resolve_named_directory_upward(path);
             if (resolved.empty())
             {
                 if (g_tb_ready || !g_tb_path.empty())
+                {
+                    g_tb_max_pieces.store(0, std::memory_order_release);
                     tb_free();
+                }
                 g_tb_path.clear();
                 g_tb_ready = false;
+                publish_tb_state_locked();
                 return false;
             }
 
@@ -45,9 +62,11 @@ namespace fast_engine
             if (g_tb_path == resolved_path)
                 return g_tb_ready;
 
+            g_tb_max_pieces.store(0, std::memory_order_release);
             tb_free();
             g_tb_path = resolved_path;
             g_tb_ready = tb_init(resolved_path.c_str());
+            publish_tb_state_locked();
             return g_tb_ready;
         }
 
@@ -199,4 +218,46 @@ namespace fast_engine
         return ensure_tb_ready_locked(config.syzygy_path);
     }
 
+    int syzygy_max_pieces() noexcept
+    {
+        return g_tb_max_pieces.load(std::memory_order_acquire);
+    }
+
+    bool probe_syzygy_wdl(const chess::Board &board, TablebaseWdl &wdl) noexcept
+    {
+        const int pieces = piece_count(board);
+        if (pieces <= 2 || pieces > syzygy_max_pieces())
+            return false;
+
+        const std::uint64_t key = board.hash();
+        const std::uint32_t generation = g_tb_generation.load(std::memory_order_acquire);
+        WdlCacheEntry &slot = t_wdl_cache[static_cast<std::size_t>(key) & (WDL_CACHE_ENTRIES - 1)];
+        if (slot.key == key && slot.generation == generation)
+        {
+            wdl = static_cast<TablebaseWdl>(slot.wdl);
+            return true;
+        }
+
+        const unsigned result = tb_probe_wdl(board.us(chess::Color::WHITE).getBits(),
+                                             board.us(chess::Color::BLACK).getBits(),
+                                             board.pieces(chess::PieceType::KING).getBits(),
+                                             board.pieces(chess::PieceType::QUEEN).getBits(),
+                                             board.pieces(chess::PieceType::ROOK).getBits(),
+                                             board.pieces(chess::PieceType::BISHOP).getBits(),
+                                             board.pieces(chess::PieceType::KNIGHT).getBits(),
+                                             board.pieces(chess::PieceType::PAWN).getBits(),
+                                             0,
+                                             0,
+                                             ep_square_for_fathom(board),
+                                             board.sideToMove() == chess::Color::WHITE);
+        if (result == TB_RESULT_FAILED)
+            return false;
+
+        slot.key = key;
+        slot.generation = generation;
+        slot.wdl = static_cast<std::int32_t>(result);
+        wdl = static_cast<TablebaseWdl>(result);
+        return true;
+    }
+
 } // namespace fast_engine
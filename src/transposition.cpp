@@ -1,9 +1,14 @@
 #include "fast_engine/transposition.hpp"
+#include "fast_engine/profile.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <istream>
 #include <limits>
+#include <ostream>
 
 namespace fast_engine
 {
@@ -24,8 +29,21 @@ namespace fast_engine
         return x + 1;
     }
 
+    // Generation at which schedule_wrap_clear() starts the background wipe; leaves
+    // headroom for a few clear()/new_search() calls before the 8-bit counter wraps.
+    static constexpr std::uint8_t WRAP_CLEAR_GEN = 248;
+
+    TranspositionTable::~TranspositionTable()
+    {
+        if (wrap_clear_thread_.joinable())
+            wrap_clear_thread_.join();
+    }
+
     void TranspositionTable::resize(std::size_t maxEntries)
     {
+        if (wrap_clear_thread_.joinable())
+            wrap_clear_thread_.join();
+
         if (maxEntries < static_cast<std::size_t>(CLUSTER_SIZE))
             maxEntries = static_cast<std::size_t>(CLUSTER_SIZE);
 
@@ -35,7 +53,7 @@ namespace fast_engine
 
         buckets = next_pow2(buckets);
 
-        table_.assign(buckets, Bucket{});
+        table_.assign(buckets, Bucket{}, fill_threads_);
         mask_ = buckets - 1;
         capacity_entries_ = buckets * static_cast<std::size_t>(CLUSTER_SIZE);
 
@@ -76,26 +94,230 @@ namespace fast_engine
         return bytes / (1024ULL * 1024ULL);
     }
 
+    TranspositionTable::EntryView TranspositionTable::load_entry(const PackedEntry &packed)
+    {
+        // atomic_ref keeps Bucket trivially copyable; relaxed loads compile to plain moves.
+        const std::uint64_t data = std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t &>(packed.data)).load(std::memory_order_relaxed);
+        const std::uint64_t meta = std::atomic_ref<std::uint64_t>(const_cast<std::uint64_t &>(packed.meta)).load(std::memory_order_relaxed);
+
+        EntryView view;
+        view.value_cp = static_cast<std::int32_t>(static_cast<std::uint32_t>(data));
+        view.static_eval_cp = static_cast<std::int32_t>(static_cast<std::uint32_t>(data >> 32));
+        view.key32 = static_cast<std::uint32_t>(meta) ^ fold_data(data);
+        view.move16 = static_cast<std::uint16_t>(meta >> 32);
+        view.depth_flag = static_cast<std::uint8_t>(meta >> 48);
+        view.gen = static_cast<std::uint8_t>(meta >> 56);
+        return view;
+    }
+
+    void TranspositionTable::store_entry(PackedEntry &packed, const EntryView &view)
+    {
+        const std::uint64_t data = pack_data(view.value_cp, view.static_eval_cp);
+        const std::uint64_t meta = pack_meta(view.key32 ^ fold_data(data), view.move16, view.depth_flag, view.gen);
+        std::atomic_ref<std::uint64_t>(packed.data).store(data, std::memory_order_relaxed);
+        std::atomic_ref<std::uint64_t>(packed.meta).store(meta, std::memory_order_relaxed);
+    }
+
     bool TranspositionTable::generation_valid(std::uint8_t gen) const
     {
         return gen != 0 && gen >= clear_gen_ && gen <= gen_;
     }
 
+    void TranspositionTable::wipe_entries()
+    {
+        // Entry-wise atomic stores so probes racing the background wipe stay well-defined.
+        const PackedEntry empty{};
+        Bucket *const base = table_.data();
+        parallel_for_slices(table_.size(), table_.fill_workers(fill_threads_), [base, empty](std::size_t begin, std::size_t end)
+                            {
+                                for (std::size_t b = begin; b < end; ++b)
+                                    for (PackedEntry &packed : base[b].e)
+                                    {
+                                        std::atomic_ref<std::uint64_t>(packed.data).store(empty.data, std::memory_order_relaxed);
+                                        std::atomic_ref<std::uint64_t>(packed.meta).store(empty.meta, std::memory_order_relaxed);
+                                    } });
+    }
+
     void TranspositionTable::hard_clear()
     {
-        for (auto &b : table_)
+        wipe_entries();
+        gen_ = 1;
+        clear_gen_ = 1;
+    }
+
+    static constexpr std::uint32_t TT_SNAPSHOT_BYTE_ORDER = 0x01020304u;
+    static constexpr std::size_t TT_SNAPSHOT_HEADER_BYTES = 48;
+    static constexpr std::size_t TT_SNAPSHOT_CHECKED_BYTES = 40;
+    // Bucket payload moves in 64 MB chunks to keep each stream call well inside streamsize.
+    static constexpr std::size_t TT_SNAPSHOT_CHUNK_BYTES = std::size_t{64} << 20;
+
+    static std::uint64_t tt_snapshot_checksum(const unsigned char *bytes, std::size_t count)
+    {
+        std::uint64_t h = 0xCBF29CE484222325ULL;
+        for (std::size_t i = 0; i < count; ++i)
+            h = (h ^ bytes[i]) * 0x100000001B3ULL;
+        return h;
+    }
+
+    template <typename T>
+    static void put_native(unsigned char *dst, std::size_t &pos, T value)
+    {
+        std::memcpy(dst + pos, &value, sizeof(T));
+        pos += sizeof(T);
+    }
+
+    template <typename T>
+    static T get_native(const unsigned char *src, std::size_t &pos)
+    {
+        T value{};
+        std::memcpy(&value, src + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    bool TranspositionTable::write_snapshot(std::ostream &out, std::string &error)
+    {
+        finish_wrap_clear();
+        unsigned char header[TT_SNAPSHOT_HEADER_BYTES] = {};
+        std::size_t pos = 0;
+        std::memcpy(header, TT_SNAPSHOT_MAGIC, sizeof(TT_SNAPSHOT_MAGIC));
+        pos += sizeof(TT_SNAPSHOT_MAGIC);
+        put_native<std::uint32_t>(header, pos, TT_SNAPSHOT_VERSION);
+        put_native<std::uint32_t>(header, pos, TT_SNAPSHOT_BYTE_ORDER);
+        put_native<std::uint32_t>(header, pos, static_cast<std::uint32_t>(sizeof(PackedEntry)));
+        put_native<std::uint32_t>(header, pos, static_cast<std::uint32_t>(CLUSTER_SIZE));
+        put_native<std::uint64_t>(header, pos, static_cast<std::uint64_t>(table_.size()));
+        put_native<std::uint8_t>(header, pos, gen_);
+        put_native<std::uint8_t>(header, pos, clear_gen_);
+        pos = TT_SNAPSHOT_CHECKED_BYTES;
+        put_native<std::uint64_t>(header, pos, tt_snapshot_checksum(header, TT_SNAPSHOT_CHECKED_BYTES));
+        out.write(reinterpret_cast<const char *>(header), static_cast<std::streamsize>(sizeof(header)));
+
+        const char *bytes = reinterpret_cast<const char *>(table_.data());
+        const std::size_t total = table_.size() * sizeof(Bucket);
+        for (std::size_t done = 0; done < total && out;)
+        {
+            const std::size_t n = std::min(TT_SNAPSHOT_CHUNK_BYTES, total - done);
+            out.write(bytes + done, static_cast<std::streamsize>(n));
+            done += n;
+        }
+        if (!out)
+        {
+            error = "write failed";
+            return false;
+        }
+        return true;
+    }
+
+    bool TranspositionTable::read_snapshot(std::istream &in, std::string &error)
+    {
+        finish_wrap_clear();
+        unsigned char header[TT_SNAPSHOT_HEADER_BYTES] = {};
+        if (!in.read(reinterpret_cast<char *>(header), static_cast<std::streamsize>(sizeof(header))))
+        {
+            error = "truncated header";
+            return false;
+        }
+        std::size_t pos = 0;
+        if (std::memcmp(header, TT_SNAPSHOT_MAGIC, sizeof(TT_SNAPSHOT_MAGIC)) != 0)
+        {
+            error = "not a TT snapshot";
+            return false;
+        }
+        pos += sizeof(TT_SNAPSHOT_MAGIC);
+        const std::uint32_t version = get_native<std::uint32_t>(header, pos);
+        const std::uint32_t byte_order = get_native<std::uint32_t>(header, pos);
+        const std::uint32_t entry_bytes = get_native<std::uint32_t>(header, pos);
+        const std::uint32_t cluster = get_native<std::uint32_t>(header, pos);
+        const std::uint64_t buckets = get_native<std::uint64_t>(header, pos);
+        const std::uint8_t gen = get_native<std::uint8_t>(header, pos);
+        const std::uint8_t clear_gen = get_native<std::uint8_t>(header, pos);
+        pos = TT_SNAPSHOT_CHECKED_BYTES;
+        const std::uint64_t checksum = get_native<std::uint64_t>(header, pos);
+        if (checksum != tt_snapshot_checksum(header, TT_SNAPSHOT_CHECKED_BYTES))
+        {
+            error = "header checksum mismatch";
+            return false;
+        }
+        if (version != TT_SNAPSHOT_VERSION || byte_order != TT_SNAPSHOT_BYTE_ORDER)
+        {
+            error = "unsupported snapshot version or byte order";
+            return false;
+        }
+        if (entry_bytes != sizeof(PackedEntry) || cluster != static_cast<std::uint32_t>(CLUSTER_SIZE))
         {
-            for (auto &e : b.e)
+            error = "entry layout mismatch";
+            return false;
+        }
+        const std::size_t max_buckets = entries_for_mb(TT_MAX_MB) / static_cast<std::size_t>(CLUSTER_SIZE);
+        if (buckets == 0 || (buckets & (buckets - 1)) != 0 || buckets > max_buckets)
+        {
+            error = "bad bucket count";
+            return false;
+        }
+        const std::size_t count = static_cast<std::size_t>(buckets);
+        const std::size_t total = count * sizeof(Bucket);
+
+        // Check the payload is there before resizing, so a short file cannot force a huge
+        // allocation or throw away the live table. Unseekable streams rely on the cap.
+        const std::streamoff here = in.tellg();
+        if (here >= 0)
+        {
+            in.seekg(0, std::ios::end);
+            const std::streamoff end = in.tellg();
+            in.clear();
+            in.seekg(here);
+            if (end >= 0 && static_cast<std::uint64_t>(end - here) < static_cast<std::uint64_t>(total))
             {
-                e = PackedEntry{};
+                error = "truncated bucket data";
+                return false;
             }
         }
+
+        if (count != table_.size())
+        {
+            table_.assign(count, Bucket{}, fill_threads_);
+            mask_ = count - 1;
+            capacity_entries_ = count * static_cast<std::size_t>(CLUSTER_SIZE);
+        }
+        char *bytes = reinterpret_cast<char *>(table_.data());
+        for (std::size_t done = 0; done < total;)
+        {
+            const std::size_t n = std::min(TT_SNAPSHOT_CHUNK_BYTES, total - done);
+            if (!in.read(bytes + done, static_cast<std::streamsize>(n)))
+            {
+                // Half-loaded buckets carry valid generations; wipe them.
+                hard_clear();
+                error = "truncated bucket data";
+                return false;
+            }
+            done += n;
+        }
+        gen_ = gen;
+        clear_gen_ = clear_gen;
+        return true;
+    }
+
+    void TranspositionTable::schedule_wrap_clear()
+    {
+        if (wrap_clear_thread_.joinable() || gen_ < WRAP_CLEAR_GEN || table_.empty())
+            return;
+        wrap_clear_thread_ = std::thread([this]()
+                                         { wipe_entries(); });
+    }
+
+    void TranspositionTable::finish_wrap_clear()
+    {
+        if (!wrap_clear_thread_.joinable())
+            return;
+        wrap_clear_thread_.join();
         gen_ = 1;
         clear_gen_ = 1;
     }
 
     void TranspositionTable::advance_generation()
     {
+        finish_wrap_clear();
         ++gen_;
         if (gen_ == 0)
             hard_clear();
@@ -118,6 +340,7 @@ namespace fast_engine
 
     std::optional<TTEntry> TranspositionTable::probe(std::uint64_t key) const
     {
+        SHAKEYBOT_PROFILE_SCOPE(ProfileStage::TtProbe);
         if (table_.empty())
             return std::nullopt;
 
@@ -125,11 +348,13 @@ namespace fast_engine
         const std::uint32_t signature = key_signature32(key);
 
         const Bucket &bucket = table_[bucket_index];
-        const PackedEntry *best = nullptr;
+        EntryView best{};
+        bool found = false;
         int best_quality = std::numeric_limits<int>::min();
 
-        for (const auto &entry : bucket.e)
+        for (const auto &packed : bucket.e)
         {
+            const EntryView entry = load_entry(packed);
             if (entry_empty(entry))
                 continue;
             if (!generation_valid(entry.gen))
@@ -145,32 +370,34 @@ namespace fast_engine
             if (entry.gen == gen_)
                 quality += 1024;
 
-            if (!best || quality > best_quality)
+            if (!found || quality > best_quality)
             {
-                best = &entry;
+                best = entry;
+                found = true;
                 best_quality = quality;
             }
         }
 
-        if (!best)
+        if (!found)
             return std::nullopt;
 
         TTEntry out;
         out.key = key;
-        out.depth = entry_depth(*best);
-        out.flag = entry_flag(*best);
-        out.value = static_cast<Score>(best->value_cp);
-        out.static_eval = static_cast<Score>(best->static_eval_cp);
-        out.current_generation = (best->gen == gen_);
+        out.depth = entry_depth(best);
+        out.flag = entry_flag(best);
+        out.value = static_cast<Score>(best.value_cp);
+        out.static_eval = static_cast<Score>(best.static_eval_cp);
+        out.current_generation = (best.gen == gen_);
 
-        out.hasMove = (best->move16 != chess::Move::NO_MOVE);
+        out.hasMove = (best.move16 != chess::Move::NO_MOVE);
         if (out.hasMove)
-            out.bestMove = chess::Move(best->move16);
+            out.bestMove = chess::Move(best.move16);
         return out;
     }
 
     void TranspositionTable::store(const TTEntry &entry)
     {
+        SHAKEYBOT_PROFILE_SCOPE(ProfileStage::TtStore);
         if (table_.empty())
             return;
 
@@ -184,28 +411,35 @@ namespace fast_engine
 
         auto write = [&](PackedEntry &pe)
         {
-            pe.gen = gen_;
-            pe.key32 = signature;
-            pe.depth_flag = pack_depth_flag(entry.depth, entry.flag);
-            pe.value_cp = value_cp;
-            pe.static_eval_cp = static_cast<std::int32_t>(entry.static_eval);
-
-            pe.move16 = entry.hasMove ? entry.bestMove.move() : chess::Move::NO_MOVE;
+            EntryView view;
+            view.gen = gen_;
+            view.key32 = signature;
+            view.depth_flag = pack_depth_flag(entry.depth, entry.flag);
+            view.value_cp = value_cp;
+            view.static_eval_cp = static_cast<std::int32_t>(entry.static_eval);
+            view.move16 = entry.hasMove ? entry.bestMove.move() : chess::Move::NO_MOVE;
+            store_entry(pe, view);
         };
 
+        // Decode the cluster once; all decisions below use this snapshot.
+        std::array<EntryView, CLUSTER_SIZE> views;
+        for (int i = 0; i < CLUSTER_SIZE; ++i)
+            views[static_cast<std::size_t>(i)] = load_entry(bucket.e[static_cast<std::size_t>(i)]);
+
         // 1) Same key (signature) in current generation: update smartly.
-        for (auto &packed : bucket.e)
+        for (int i = 0; i < CLUSTER_SIZE; ++i)
         {
-            if (packed.gen != gen_)
+            EntryView &view = views[static_cast<std::size_t>(i)];
+            if (view.gen != gen_)
                 continue;
-            if (entry_empty(packed))
+            if (entry_empty(view))
                 continue;
-            if (packed.key32 != signature)
+            if (view.key32 != signature)
                 continue;
 
-            const int old_depth = entry_depth(packed);
+            const int old_depth = entry_depth(view);
             const int new_depth = std::clamp(entry.depth, 0, 63);
-            const bool old_exact = (entry_flag(packed) == TT_EXACT);
+            const bool old_exact = (entry_flag(view) == TT_EXACT);
             const bool new_exact = (entry.flag == TT_EXACT);
 
             const bool replace =
@@ -214,33 +448,41 @@ namespace fast_engine
 
             if (replace)
             {
-                write(packed);
+                write(bucket.e[static_cast<std::size_t>(i)]);
             }
             else
             {
                 // Keep old eval, but allow best-move fill-in if old had none.
-                if (entry.static_eval != TT_NO_STATIC_EVAL && packed.static_eval_cp == TT_NO_STATIC_EVAL)
-                    packed.static_eval_cp = static_cast<std::int32_t>(entry.static_eval);
-                if (entry.hasMove && packed.move16 == chess::Move::NO_MOVE)
+                bool changed = false;
+                if (entry.static_eval != TT_NO_STATIC_EVAL && view.static_eval_cp == TT_NO_STATIC_EVAL)
+                {
+                    view.static_eval_cp = static_cast<std::int32_t>(entry.static_eval);
+                    changed = true;
+                }
+                if (entry.hasMove && view.move16 == chess::Move::NO_MOVE)
                 {
-                    packed.move16 = entry.bestMove.move();
+                    view.move16 = entry.bestMove.move();
+                    changed = true;
                 }
+                if (changed)
+                    store_entry(bucket.e[static_cast<std::size_t>(i)], view);
             }
             return;
         }
 
         // 2) Prefer an invalid/old-gen/empty slot first (age/generation).
-        for (auto &packed : bucket.e)
+        for (int i = 0; i < CLUSTER_SIZE; ++i)
         {
-            if (packed.gen != gen_ || entry_empty(packed))
+            const EntryView &view = views[static_cast<std::size_t>(i)];
+            if (view.gen != gen_ || entry_empty(view))
             {
-                write(packed);
+                write(bucket.e[static_cast<std::size_t>(i)]);
                 return;
             }
         }
 
         // 3) Bucket full: replace the lowest-quality entry.
-        auto replacement_quality = [&](const PackedEntry &packed) -> int
+        auto replacement_quality = [&](const EntryView &packed) -> int
         {
             // Lower => more replaceable.
             //
@@ -266,20 +508,20 @@ namespace fast_engine
             return quality;
         };
 
-        PackedEntry *victim = &bucket.e[0];
-        int victim_quality = replacement_quality(bucket.e[0]);
+        int victim = 0;
+        int victim_quality = replacement_quality(views[0]);
 
-        for (auto &packed : bucket.e)
+        for (int i = 1; i < CLUSTER_SIZE; ++i)
         {
-            const int quality = replacement_quality(packed);
+            const int quality = replacement_quality(views[static_cast<std::size_t>(i)]);
             if (quality < victim_quality)
             {
                 victim_quality = quality;
-                victim = &packed;
+                victim = i;
             }
         }
 
-        write(*victim);
+        write(bucket.e[static_cast<std::size_t>(victim)]);
     }
 
 } // namespace fast_engine
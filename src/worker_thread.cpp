@@ -0,0 +1,81 @@
+#include "fast_engine/worker_thread.hpp"
+
+namespace fast_engine
+{
+
+    WorkerThread::WorkerThread()
+        : thread_(&WorkerThread::loop, this)
+    {
+    }
+
+    WorkerThread::~WorkerThread()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]
+                     { return !busy_; });
+            quit_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void WorkerThread::start(std::function<void()> job)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]
+                     { return !busy_; });
+            job_ = std::move(job);
+            busy_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    void WorkerThread::wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]
+                 { return !busy_; });
+    }
+
+    bool WorkerThread::busy() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return busy_;
+    }
+
+    void WorkerThread::loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
+        {
+            cv_.wait(lock, [this]
+                     { return busy_ || quit_; });
+            if (!busy_)
+                return;
+            std::function<void()> job = std::move(job_);
+            job_ = nullptr;
+            lock.unlock();
+            job();
+            // Release the job's captures before reporting idle.
+            job = nullptr;
+            lock.lock();
+            busy_ = false;
+            cv_.notify_all();
+        }
+    }
+
+    void WorkerPool::reserve(int count)
+    {
+        while (size() < count)
+            workers_.push_back(std::make_unique<WorkerThread>());
+    }
+
+    void WorkerPool::wait_all()
+    {
+        for (const std::unique_ptr<WorkerThread> &worker : workers_)
+            worker->wait();
+    }
+
+} // namespace fast_engine